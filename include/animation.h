@@ -2,6 +2,7 @@
 #define _ANIMATION_H_
 
 #include "timer.h"
+#include "render_snapshot.h"
 
 #include <SDL.h>
 #include <vector>
@@ -134,21 +135,18 @@ public:
      }
 
      /**
-      * @brief 渲染当前动画帧
-      * @param renderer SDL渲染器
+      * @brief 把当前动画帧录制到渲染快照
+      * @param snapshot 渲染快照
       * @param pos_dst 目标位置
       * @param angle 旋转角度（默认为0）
       *
       * 此方法应当在游戏循环的渲染阶段调用
       */
-     void on_render(SDL_Renderer *renderer, const SDL_Point &pos_dst, double angle = 0) const
+     void on_render(RenderSnapshot &snapshot, const SDL_Point &pos_dst, double angle = 0) const
      {
-          static SDL_Rect rect_dst;
+          const SDL_Rect rect_dst = {pos_dst.x, pos_dst.y, width_frame, height_frame};
 
-          rect_dst.x = pos_dst.x, rect_dst.y = pos_dst.y;
-          rect_dst.w = width_frame, rect_dst.h = height_frame;
-
-          SDL_RenderCopyEx(renderer, texture, &rect_src_list[idx_frame], &rect_dst, angle, nullptr, SDL_RendererFlip::SDL_FLIP_NONE);
+          snapshot.draw_texture(texture, &rect_src_list[idx_frame], rect_dst, angle);
      }
 
 private:
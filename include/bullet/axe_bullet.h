@@ -3,7 +3,8 @@
 
 // 包含必要的头文件
 #include "bullet/bullet.h"             // 子弹基类
-#include "manager/resources_manager.h" // 资源管理器，用于加载纹理和音效
+#include "manager/resources_manager.h" // 资源管理器，用于加载纹理
+#include "command_buffer.h"            // 指令缓冲，用于播放命中音效
 
 // 斧头子弹类：继承自Bullet基类
 // 特点：
@@ -48,20 +49,20 @@ public:
      // 3. 调用基类的碰撞处理
      void on_collide(Enemy *enemy) override
      {
-          // 获取音效池
-          static const ResourcesManager::SoundPool &sound_pool = ResourcesManager::instance()->get_sound_pool();
+          // 命中音效写入指令缓冲，在同步点播放
+          static CommandBuffer *command_buffer = CommandBuffer::instance();
 
           // 随机选择并播放命中音效
           switch (rand() % 3)
           {
           case 0:
-               Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_AxeHit_1)->second, 0);
+               command_buffer->play_sound(ResID::Sound_AxeHit_1, position);
                break;
           case 1:
-               Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_AxeHit_2)->second, 0);
+               command_buffer->play_sound(ResID::Sound_AxeHit_2, position);
                break;
           case 2:
-               Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_AxeHit_3)->second, 0);
+               command_buffer->play_sound(ResID::Sound_AxeHit_3, position);
                break;
           }
 
@@ -5,7 +5,9 @@
 #include "game_map/vector2.h"       // 二维向量类，用于位置和速度
 #include "enemy/enemy.h"            // 敌人类，用于碰撞检测
 #include "animation.h"              // 动画类，用于子弹动画
+#include "camera.h"                 // 摄像机，用于视锥裁剪和坐标转换
 #include "manager/config_manager.h" // 配置管理器，用于读取地图边界
+#include "command_buffer.h"         // 指令缓冲，提供敌人句柄类型
 
 // 子弹类：游戏中的子弹实体
 // 功能包括：
@@ -14,6 +16,7 @@
 // 3. 动画系统：支持旋转和普通动画
 // 4. 边界检测：超出地图边界时自动销毁
 // 5. 伤害系统：支持范围伤害和单体伤害
+// 6. 追踪系统：持有目标敌人的句柄时每帧预判拦截点并调整飞行方向
 class Bullet
 {
 public:
@@ -28,8 +31,6 @@ public:
      void set_velocity(const Vector2 &velocity)
      {
           this->velocity = velocity;
-          printf("[DEBUG] Bullet velocity set to: (%.2f, %.2f), length: %.2f\n",
-                 velocity.x, velocity.y, velocity.length());
 
           if (can_rotated)
           {
@@ -44,6 +45,7 @@ public:
      void set_position(const Vector2 &position)
      {
           this->position = position;
+          this->position_last = position;
      }
 
      // 设置子弹伤害
@@ -53,6 +55,19 @@ public:
           this->damage = damage;
      }
 
+     // 设置发射子弹的防御塔，命中时伤害记到该防御塔上
+     // @param tower_source: 防御塔句柄
+     void set_tower_source(TowerHandle tower_source)
+     {
+          this->tower_source = tower_source;
+     }
+
+     // 获取发射子弹的防御塔
+     TowerHandle get_tower_source() const
+     {
+          return tower_source;
+     }
+
      // 获取子弹尺寸
      const Vector2 &get_size() const
      {
@@ -65,6 +80,12 @@ public:
           return position;
      }
 
+     // 获取子弹上一帧的位置，与当前位置构成本帧扫过的线段，用于连续碰撞检测
+     const Vector2 &get_position_last() const
+     {
+          return position_last;
+     }
+
      // 获取子弹伤害
      double get_damage() const
      {
@@ -118,15 +139,10 @@ public:
           // 更新动画
           animation.on_update(delta);
 
-          // 记录更新前的位置
-          Vector2 old_position = position;
-
-          // 更新位置：位置 += 速度 * 时间
+          // 更新位置：位置 += 速度 * 时间，记录移动前的位置供连续碰撞检测使用
+          position_last = position;
           position += velocity * (delta * 100); // 增加时间缩放因子
 
-          printf("[DEBUG] Bullet update - Delta: %.6f, Old pos: (%.2f, %.2f), New pos: (%.2f, %.2f), Velocity: (%.2f, %.2f)\n",
-                 delta, old_position.x, old_position.y, position.x, position.y, velocity.x, velocity.y);
-
           // 获取地图边界
           static const SDL_Rect &rect_map = ConfigManager::instance()->rect_tile_map;
 
@@ -138,20 +154,26 @@ public:
      }
 
      // 渲染子弹
-     // @param renderer: SDL渲染器
+     // @param snapshot: 渲染快照
+     // @param camera: 摄像机，用于视锥裁剪和坐标转换
      // 功能：
-     // 1. 计算渲染位置（居中显示）
-     // 2. 渲染当前动画帧，支持旋转
-     virtual void on_render(SDL_Renderer *renderer)
+     // 1. 不在视图内的子弹直接跳过
+     // 2. 计算渲染位置（居中显示）
+     // 3. 渲染当前动画帧，支持旋转
+     virtual void on_render(RenderSnapshot &snapshot, const Camera &camera)
      {
           static SDL_Point point;
 
+          if (!camera.is_visible(position, size))
+               return;
+
           // 计算渲染位置（居中显示）
-          point.x = (int)(position.x - size.x / 2);
-          point.y = (int)(position.y - size.y / 2);
+          const Vector2 pos_view = camera.world_to_view(position);
+          point.x = (int)(pos_view.x - size.x / 2);
+          point.y = (int)(pos_view.y - size.y / 2);
 
           // 渲染当前动画帧，支持旋转
-          animation.on_render(renderer, point, angle_anim_rotated);
+          animation.on_render(snapshot, point, angle_anim_rotated);
      }
 
      // 处理与敌人的碰撞
@@ -184,11 +206,99 @@ public:
           return is_valid_flag;
      }
 
+     // 设置追踪目标
+     // @param handle: 目标敌人的句柄，空句柄表示直线飞行
+     void set_target_enemy(EnemyHandle handle)
+     {
+          enemy_target = handle;
+     }
+
+     // 获取追踪目标的句柄
+     EnemyHandle get_target_enemy() const
+     {
+          return enemy_target;
+     }
+
+     // 检查子弹是否正在追踪目标
+     bool is_homing() const
+     {
+          return !enemy_target.is_null();
+     }
+
+     // 丢失追踪目标，之后沿当前方向直线飞行
+     void lose_target()
+     {
+          enemy_target = EnemyHandle();
+     }
+
+     // 朝目标的预判拦截点调整飞行方向，速率保持不变
+     // @param target_position: 目标当前位置
+     // @param target_velocity: 目标当前速度（像素/秒）
+     void steer_to(const Vector2 &target_position, const Vector2 &target_velocity)
+     {
+          double speed = velocity.length();
+          if (speed <= 0)
+               return;
+
+          // 子弹位移按 velocity * delta * 100 计算，换算为像素/秒后再求拦截点
+          Vector2 position_aim = predict_intercept(position, speed * 100, target_position, target_velocity);
+          Vector2 direction = position_aim - position;
+          if (direction.length() <= 0)
+               return;
+
+          set_velocity(direction.normalize() * speed);
+     }
+
+     // 预判拦截点：求解 |D + V * t| = s * t 的最小正根，其中D为目标相对射手的位置
+     // 无解（目标比子弹快且正在远离）时直接瞄准目标当前位置
+     // @param position_src: 射手位置
+     // @param speed: 子弹速率（像素/秒）
+     // @param target_position: 目标当前位置
+     // @param target_velocity: 目标当前速度（像素/秒）
+     // @return: 拦截点位置
+     static Vector2 predict_intercept(const Vector2 &position_src, double speed, const Vector2 &target_position, const Vector2 &target_velocity)
+     {
+          Vector2 distance = target_position - position_src;
+
+          double a = target_velocity * target_velocity - speed * speed;
+          double b = 2 * (distance * target_velocity);
+          double c = distance * distance;
+
+          double t = -1;
+          if (std::abs(a) < 1e-6)
+          {
+               // 目标与子弹速率相同，方程退化为一次方程
+               if (std::abs(b) > 1e-6)
+                    t = -c / b;
+          }
+          else
+          {
+               double discriminant = b * b - 4 * a * c;
+               if (discriminant >= 0)
+               {
+                    double sqrt_discriminant = std::sqrt(discriminant);
+                    double t1 = (-b - sqrt_discriminant) / (2 * a);
+                    double t2 = (-b + sqrt_discriminant) / (2 * a);
+                    if (t1 > 0 && t2 > 0)
+                         t = std::min(t1, t2);
+                    else
+                         t = std::max(t1, t2);
+               }
+          }
+
+          if (t <= 0)
+               return target_position;
+
+          return target_position + target_velocity * t;
+     }
+
 protected:
      Vector2 size;     // 子弹尺寸
      Vector2 velocity; // 子弹速度
      Vector2 position; // 子弹位置
 
+     Vector2 position_last; // 上一帧的子弹位置
+
      Animation animation;      // 子弹动画
      bool can_rotated = false; // 是否可以旋转
 
@@ -200,6 +310,8 @@ private:
      bool is_valid_flag = true;     // 子弹是否有效
      bool is_collisional = true;    // 是否可以碰撞
      double angle_anim_rotated = 0; // 动画旋转角度
+     EnemyHandle enemy_target;      // 追踪目标，空句柄表示直线飞行
+     TowerHandle tower_source;      // 发射子弹的防御塔
 };
 
 #endif // !_BULLET_H_
@@ -3,7 +3,8 @@
 
 // 包含必要的头文件
 #include "bullet/bullet.h"             // 子弹基类
-#include "manager/resources_manager.h" // 资源管理器，用于加载纹理和音效
+#include "manager/resources_manager.h" // 资源管理器，用于加载纹理
+#include "command_buffer.h"            // 指令缓冲，用于播放命中音效
 
 // 炮弹子弹类：继承自Bullet基类
 // 特点：
@@ -14,6 +15,9 @@
 class ShellBullet : public Bullet
 {
 public:
+     // 爆炸伤害范围（像素），瞬间命中的炮塔也按这个范围结算
+     static constexpr double damage_range_explode = 96;
+
      // 构造函数：初始化炮弹子弹的属性
      // 功能：
      // 1. 加载炮弹和爆炸纹理
@@ -53,7 +57,7 @@ public:
                    make_invalid();
               });
 
-          damage_range = 96;        // 设置伤害范围为96像素
+          damage_range = damage_range_explode; // 设置伤害范围为96像素
           size.x = 48, size.y = 48; // 设置尺寸为48x48像素
      }
 
@@ -76,24 +80,31 @@ public:
      }
 
      // 渲染炮弹
-     // @param renderer: SDL渲染器
+     // @param snapshot: 渲染快照
+     // @param camera: 摄像机，用于视锥裁剪和坐标转换
      // 功能：
      // 1. 如果可碰撞，渲染飞行状态
      // 2. 如果不可碰撞（已爆炸），渲染爆炸动画
-     void on_render(SDL_Renderer *renderer) override
+     void on_render(RenderSnapshot &snapshot, const Camera &camera) override
      {
           if (can_collide())
           {
-               Bullet::on_render(renderer); // 渲染飞行状态
+               Bullet::on_render(snapshot, camera); // 渲染飞行状态
                return;
           }
 
+          // 爆炸效果尺寸为96x96
+          static const Vector2 size_explode = {96, 96};
+          if (!camera.is_visible(position, size_explode))
+               return;
+
           // 计算爆炸效果渲染位置（居中显示）
           static SDL_Point point;
-          point.x = (int)(position.x - 96 / 2); // 爆炸效果尺寸为96x96
-          point.y = (int)(position.y - 96 / 2);
+          const Vector2 pos_view = camera.world_to_view(position);
+          point.x = (int)(pos_view.x - size_explode.x / 2);
+          point.y = (int)(pos_view.y - size_explode.y / 2);
 
-          animation_explode.on_render(renderer, point); // 渲染爆炸动画
+          animation_explode.on_render(snapshot, point); // 渲染爆炸动画
      }
 
      // 处理与敌人的碰撞
@@ -103,11 +114,11 @@ public:
      // 2. 禁用碰撞检测，开始爆炸动画
      void on_collide(Enemy *enemy) override
      {
-          // 获取音效池
-          static const ResourcesManager::SoundPool &sound_pool = ResourcesManager::instance()->get_sound_pool();
+          // 命中音效写入指令缓冲，在同步点播放
+          static CommandBuffer *command_buffer = CommandBuffer::instance();
 
           // 播放命中音效
-          Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_ShellHit)->second, 0);
+          command_buffer->play_sound(ResID::Sound_ShellHit, position);
 
           // 禁用碰撞检测，开始爆炸动画
           disable_collide();
@@ -0,0 +1,243 @@
+#ifndef _CAMERA_H_
+#define _CAMERA_H_
+
+#include "game_map/vector2.h"
+
+#include <SDL.h>
+#include <algorithm>
+
+/**
+ * @brief 摄像机类，负责世界坐标与屏幕坐标之间的转换
+ *
+ * 世界坐标以地图左上角为原点，单位为像素。渲染世界层时先用
+ * SDL_RenderSetScale 设置缩放，再把世界坐标减去摄像机位置得到视图坐标。
+ * 支持方向键平移、鼠标中键拖拽平移、滚轮以光标为中心缩放，
+ * 并提供视锥裁剪查询，使超大地图只绘制可见部分。
+ */
+class Camera
+{
+public:
+     Camera() = default;
+     ~Camera() = default;
+
+     /**
+      * @brief 设置视口尺寸（屏幕像素）
+      * @param width 视口宽度
+      * @param height 视口高度
+      */
+     void set_view_size(int width, int height)
+     {
+          size_view.x = width, size_view.y = height;
+          clamp_position();
+     }
+
+     /**
+      * @brief 设置世界边界，摄像机不会移出该区域
+      * @param rect_world 世界区域（通常为地图区域）
+      */
+     void set_world_rect(const SDL_Rect &rect_world)
+     {
+          this->rect_world = rect_world;
+          clamp_position();
+     }
+
+     /**
+      * @brief 把视图中心移动到指定世界坐标
+      * @param center 世界坐标
+      */
+     void look_at(const Vector2 &center)
+     {
+          position = center - get_view_size_world() * 0.5;
+          clamp_position();
+     }
+
+     /**
+      * @brief 以屏幕上的某一点为中心缩放，缩放前后该点对应的世界坐标不变
+      * @param factor 缩放倍率（大于1放大，小于1缩小）
+      * @param pos_screen 缩放中心（屏幕坐标）
+      */
+     void zoom_at(double factor, const Vector2 &pos_screen)
+     {
+          Vector2 pos_world = screen_to_world(pos_screen);
+          zoom = std::min(std::max(zoom * factor, min_zoom), max_zoom);
+          position = pos_world - pos_screen * (1 / zoom);
+          clamp_position();
+     }
+
+     /**
+      * @brief 获取缩放倍率
+      */
+     double get_zoom() const
+     {
+          return zoom;
+     }
+
+     /**
+      * @brief 获取摄像机位置（视图左上角的世界坐标）
+      */
+     const Vector2 &get_position() const
+     {
+          return position;
+     }
+
+     /**
+      * @brief 获取视图中心的世界坐标
+      */
+     Vector2 get_center() const
+     {
+          return position + get_view_size_world() * 0.5;
+     }
+
+     /**
+      * @brief 获取可见区域（世界坐标）
+      */
+     SDL_Rect get_view_rect() const
+     {
+          Vector2 size = get_view_size_world();
+          return {(int)position.x, (int)position.y, (int)size.x + 1, (int)size.y + 1};
+     }
+
+     /**
+      * @brief 世界坐标转视图坐标（缩放前的逻辑坐标）
+      * @param pos_world 世界坐标
+      */
+     Vector2 world_to_view(const Vector2 &pos_world) const
+     {
+          return pos_world - position;
+     }
+
+     /**
+      * @brief 屏幕坐标转世界坐标
+      * @param pos_screen 屏幕坐标
+      */
+     Vector2 screen_to_world(const Vector2 &pos_screen) const
+     {
+          return pos_screen * (1 / zoom) + position;
+     }
+
+     /**
+      * @brief 视锥裁剪：判断以center为中心、尺寸为size的矩形是否在视图内
+      * @param center 矩形中心（世界坐标）
+      * @param size 矩形尺寸
+      * @return 与可见区域相交返回true
+      */
+     bool is_visible(const Vector2 &center, const Vector2 &size) const
+     {
+          Vector2 size_view_world = get_view_size_world();
+          return center.x + size.x / 2 >= position.x && center.x - size.x / 2 <= position.x + size_view_world.x &&
+                 center.y + size.y / 2 >= position.y && center.y - size.y / 2 <= position.y + size_view_world.y;
+     }
+
+     /**
+      * @brief 处理输入事件：方向键平移、中键拖拽平移、滚轮缩放
+      * @param event SDL事件
+      */
+     void on_input(const SDL_Event &event)
+     {
+          switch (event.type)
+          {
+          case SDL_KEYDOWN:
+          case SDL_KEYUP:
+          {
+               bool is_down = event.type == SDL_KEYDOWN;
+               switch (event.key.keysym.sym)
+               {
+               case SDLK_LEFT:
+                    is_pan_left = is_down;
+                    break;
+               case SDLK_RIGHT:
+                    is_pan_right = is_down;
+                    break;
+               case SDLK_UP:
+                    is_pan_up = is_down;
+                    break;
+               case SDLK_DOWN:
+                    is_pan_down = is_down;
+                    break;
+               default:
+                    break;
+               }
+          }
+          break;
+          case SDL_MOUSEBUTTONDOWN:
+               if (event.button.button == SDL_BUTTON_MIDDLE)
+                    is_dragging = true;
+               break;
+          case SDL_MOUSEBUTTONUP:
+               if (event.button.button == SDL_BUTTON_MIDDLE)
+                    is_dragging = false;
+               break;
+          case SDL_MOUSEMOTION:
+               pos_cursor.x = event.motion.x, pos_cursor.y = event.motion.y;
+               if (is_dragging)
+               {
+                    position -= Vector2(event.motion.xrel, event.motion.yrel) * (1 / zoom);
+                    clamp_position();
+               }
+               break;
+          case SDL_MOUSEWHEEL:
+               if (event.wheel.y != 0)
+                    zoom_at(event.wheel.y > 0 ? zoom_step : 1 / zoom_step, pos_cursor);
+               break;
+          default:
+               break;
+          }
+     }
+
+     /**
+      * @brief 更新摄像机：处理方向键平移
+      * @param delta 时间增量（秒）
+      */
+     void on_update(double delta)
+     {
+          Vector2 direction = Vector2(is_pan_right - is_pan_left, is_pan_down - is_pan_up).normalize();
+          if (direction.approx_zero())
+               return;
+
+          position += direction * (pan_speed * delta / zoom);
+          clamp_position();
+     }
+
+private:
+     Vector2 position;                         // 视图左上角的世界坐标
+     Vector2 size_view = {1280, 720};          // 视口尺寸（屏幕像素）
+     SDL_Rect rect_world = {0, 0, 0, 0};       // 世界边界
+     double zoom = 1;                          // 缩放倍率
+     Vector2 pos_cursor;                       // 最近一次的光标位置（屏幕坐标）
+
+     bool is_dragging = false;
+     bool is_pan_up = false;
+     bool is_pan_down = false;
+     bool is_pan_left = false;
+     bool is_pan_right = false;
+
+     const double min_zoom = 0.25;  // 最小缩放倍率
+     const double max_zoom = 2;     // 最大缩放倍率
+     const double zoom_step = 1.1;  // 滚轮每格的缩放倍率
+     const double pan_speed = 800;  // 方向键平移速度（屏幕像素/秒）
+
+private:
+     // 视口尺寸换算为世界尺寸
+     Vector2 get_view_size_world() const
+     {
+          return size_view * (1 / zoom);
+     }
+
+     // 限制摄像机位置：世界比视口大时不移出世界边界，比视口小时居中
+     void clamp_position()
+     {
+          Vector2 size = get_view_size_world();
+
+          if (rect_world.w <= size.x)
+               position.x = rect_world.x + (rect_world.w - size.x) / 2;
+          else
+               position.x = std::min(std::max(position.x, (double)rect_world.x), rect_world.x + rect_world.w - size.x);
+
+          if (rect_world.h <= size.y)
+               position.y = rect_world.y + (rect_world.h - size.y) / 2;
+          else
+               position.y = std::min(std::max(position.y, (double)rect_world.y), rect_world.y + rect_world.h - size.y);
+     }
+};
+
+#endif // !_CAMERA_H_
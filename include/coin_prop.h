@@ -5,6 +5,8 @@
 #include "game_map/tile.h"             // 瓦片类，用于获取瓦片大小常量
 #include "timer.h"                     // 计时器类，用于控制金币动画和消失时间
 #include "game_map/vector2.h"          // 向量类，用于处理位置和速度
+#include "camera.h"                    // 摄像机，用于视锥裁剪和坐标转换
+#include "render_snapshot.h"           // 渲染快照，用于录制绘制指令
 #include "manager/resources_manager.h" // 资源管理器，用于获取金币纹理
 
 #include <SDL.h>
@@ -100,8 +102,9 @@ public:
      }
 
      // 渲染金币
-     // @param renderer: SDL渲染器
-     void on_render(SDL_Renderer *renderer)
+     // @param snapshot: 渲染快照
+     // @param camera: 摄像机，用于视锥裁剪和坐标转换
+     void on_render(RenderSnapshot &snapshot, const Camera &camera)
      {
           // 创建目标矩形
           static SDL_Rect rect = {0, 0, (int)size.x, (int)size.y};
@@ -111,12 +114,16 @@ public:
                                              .find(ResID::Tex_Coin)
                                              ->second;
 
+          if (!camera.is_visible(position, size))
+               return;
+
           // 设置渲染位置（居中）
-          rect.x = (int)(position.x - size.x / 2);
-          rect.y = (int)(position.y - size.y / 2);
+          const Vector2 pos_view = camera.world_to_view(position);
+          rect.x = (int)(pos_view.x - size.x / 2);
+          rect.y = (int)(pos_view.y - size.y / 2);
 
           // 渲染金币
-          SDL_RenderCopy(renderer, tex_coin, nullptr, &rect);
+          snapshot.draw_texture(tex_coin, nullptr, rect);
      }
 
 private:
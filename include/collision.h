@@ -0,0 +1,58 @@
+#ifndef _COLLISION_H_
+#define _COLLISION_H_
+
+#include "game_map/vector2.h"
+
+#include <cmath>
+#include <algorithm>
+
+/**
+ * @brief 线段与轴对齐包围盒（AABB）的相交测试（slab法）
+ *
+ * 把线段写成 p0 + (p1 - p0) * t，t ∈ [0, 1]，分别求出线段进入、离开
+ * x、y两组平行边界的参数区间，两个区间的交集非空即相交。
+ * 用于瞬间命中武器的射线检测，以及高速子弹的连续碰撞检测（避免穿透）。
+ *
+ * @param p0 线段起点
+ * @param p1 线段终点
+ * @param center 包围盒中心
+ * @param size 包围盒尺寸
+ * @param t_hit 输出：首次接触点在线段上的参数（0-1），起点在盒内时为0，可为nullptr
+ * @return 是否相交
+ */
+inline bool intersect_segment_aabb(const Vector2 &p0, const Vector2 &p1, const Vector2 &center, const Vector2 &size, double *t_hit = nullptr)
+{
+     const double min_bound[2] = {center.x - size.x / 2, center.y - size.y / 2};
+     const double max_bound[2] = {center.x + size.x / 2, center.y + size.y / 2};
+     const double origin[2] = {p0.x, p0.y};
+     const double direction[2] = {p1.x - p0.x, p1.y - p0.y};
+
+     double t_enter = 0, t_exit = 1;
+     for (int axis = 0; axis < 2; axis++)
+     {
+          // 线段与该轴平行：起点不在两条边界之间则不可能相交
+          if (std::abs(direction[axis]) < 1e-9)
+          {
+               if (origin[axis] < min_bound[axis] || origin[axis] > max_bound[axis])
+                    return false;
+               continue;
+          }
+
+          double t_near = (min_bound[axis] - origin[axis]) / direction[axis];
+          double t_far = (max_bound[axis] - origin[axis]) / direction[axis];
+          if (t_near > t_far)
+               std::swap(t_near, t_far);
+
+          t_enter = std::max(t_enter, t_near);
+          t_exit = std::min(t_exit, t_far);
+          if (t_enter > t_exit)
+               return false;
+     }
+
+     if (t_hit)
+          *t_hit = t_enter;
+
+     return true;
+}
+
+#endif // !_COLLISION_H_
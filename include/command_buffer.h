@@ -0,0 +1,192 @@
+#ifndef _COMMAND_BUFFER_H_
+#define _COMMAND_BUFFER_H_
+
+#include "job_system.h"
+#include "slot_map.h"
+#include "manager/manager.h"
+#include "game_map/vector2.h"
+#include "bullet/bullet_type.h"
+#include "manager/resources_manager.h"
+
+#include <mutex>
+#include <deque>
+#include <vector>
+
+class Enemy;
+class Tower;
+
+// 敌人句柄：敌人被移除后自动失效，指令结算时不会访问已删除的敌人
+typedef SlotHandle<Enemy *> EnemyHandle;
+
+// 防御塔句柄：用于把伤害和击杀记到造成伤害的防御塔上，防御塔被移除后自动失效
+typedef SlotHandle<Tower *> TowerHandle;
+
+// 指令缓冲：收集一帧内跨管理器的副作用，在同步点统一执行
+// 实体更新期间不再直接修改其他管理器（生成子弹、掉落金币、造成伤害、治疗、播放音效），
+// 而是追加类型化的指令，由GameManager在所有更新结束、移除无效实体之前批量执行
+// 功能包括：
+// 1. 消除迭代失效：遍历实体列表时不会向同一列表插入元素或修改其他实体
+// 2. 支持并行：并行区域内追加的指令按区块分别缓存，执行时按区块顺序遍历，结果与串行一致
+// 3. 批量执行：同类指令连续存放、按类型分批执行
+class CommandBuffer : public Manager<CommandBuffer>
+{
+     friend class Manager<CommandBuffer>;
+
+public:
+     // 治疗：恢复范围内所有敌人的生命值
+     struct Heal
+     {
+          Vector2 position;     // 治疗中心
+          double radius = 0;    // 治疗半径
+          double intensity = 0; // 恢复量
+     };
+
+     // 造成伤害：enemy_target非空时为单体伤害，否则对position周围damage_range内的敌人造成范围伤害
+     struct ApplyDamage
+     {
+          EnemyHandle enemy_target;  // 单体伤害的目标
+          Vector2 position;          // 范围伤害的中心
+          double damage = 0;         // 伤害值
+          double damage_range = -1;  // 范围伤害半径
+          bool can_drop_coin = true; // 击杀时是否按敌人的奖励倍率掉落金币
+          bool is_slow_down = false; // 是否附带减速
+          TowerHandle tower_source;  // 造成伤害的防御塔，空句柄表示不计入任何防御塔
+     };
+
+     // 生成金币道具：按概率在指定位置掉落
+     struct SpawnCoin
+     {
+          Vector2 position; // 生成位置
+          double ratio = 1; // 掉落概率（0-1之间）
+     };
+
+     // 生成子弹
+     struct SpawnBullet
+     {
+          BulletType type = BulletType::Arrow; // 子弹类型
+          Vector2 position;                    // 初始位置
+          Vector2 target_position;             // 目标位置
+          Vector2 velocity;                    // 初始速度，为零时朝目标位置发射
+          double damage = 0;                   // 伤害值
+          double damage_range = -1;            // 伤害范围，-1表示单体伤害
+          EnemyHandle enemy_target;            // 追踪目标，空句柄表示直线飞行
+          TowerHandle tower_source;            // 发射子弹的防御塔
+     };
+
+     // 播放音效
+     struct PlaySound
+     {
+          ResID id = ResID::Sound_Coin; // 音效资源ID
+          Vector2 position;             // 声源位置
+          bool has_position = false;    // 是否为定位音效
+     };
+
+public:
+     void heal(const Vector2 &position, double radius, double intensity)
+     {
+          get_chunk().heal_list.push_back({position, radius, intensity});
+     }
+
+     void apply_damage(const ApplyDamage &command)
+     {
+          get_chunk().apply_damage_list.push_back(command);
+     }
+
+     void spawn_coin(const Vector2 &position, double ratio)
+     {
+          get_chunk().spawn_coin_list.push_back({position, ratio});
+     }
+
+     void spawn_bullet(const SpawnBullet &command)
+     {
+          get_chunk().spawn_bullet_list.push_back(command);
+     }
+
+     void play_sound(ResID id)
+     {
+          get_chunk().play_sound_list.push_back({id, Vector2(), false});
+     }
+
+     void play_sound(ResID id, const Vector2 &position)
+     {
+          get_chunk().play_sound_list.push_back({id, position, true});
+     }
+
+     // 按区块顺序、提交顺序遍历某一类指令（仅在同步点调用）
+     // @param func: 指令处理函数
+     template <typename Command, typename Func>
+     void for_each(Func func) const
+     {
+          for (const Chunk &chunk : chunk_list)
+               for (const Command &command : chunk.template get_list<Command>())
+                    func(command);
+     }
+
+     // 清空所有指令，保留已分配的容量供下一帧复用
+     void clear()
+     {
+          for (Chunk &chunk : chunk_list)
+          {
+               chunk.heal_list.clear();
+               chunk.apply_damage_list.clear();
+               chunk.spawn_coin_list.clear();
+               chunk.spawn_bullet_list.clear();
+               chunk.play_sound_list.clear();
+          }
+     }
+
+protected:
+     CommandBuffer()
+     {
+          chunk_list.resize(1);
+     }
+
+     ~CommandBuffer() = default;
+
+private:
+     // 单个区块的指令，并行区域外提交的指令归入第0个区块
+     struct Chunk
+     {
+          std::vector<Heal> heal_list;
+          std::vector<ApplyDamage> apply_damage_list;
+          std::vector<SpawnCoin> spawn_coin_list;
+          std::vector<SpawnBullet> spawn_bullet_list;
+          std::vector<PlaySound> play_sound_list;
+
+          template <typename Command>
+          const std::vector<Command> &get_list() const;
+     };
+
+private:
+     std::mutex mutex;
+     std::deque<Chunk> chunk_list; // 按区块索引存放的指令，deque扩容时已有区块的引用保持有效
+
+private:
+     // 获取当前线程所在区块的指令存储
+     Chunk &get_chunk()
+     {
+          if (!JobSystem::is_in_parallel_region())
+               return chunk_list[0];
+
+          size_t idx_chunk = JobSystem::get_current_chunk();
+
+          // 区块数量只在并行区域内增长，加锁保证扩容时其他线程不会同时访问
+          std::lock_guard<std::mutex> lock(mutex);
+          if (idx_chunk >= chunk_list.size())
+               chunk_list.resize(idx_chunk + 1);
+          return chunk_list[idx_chunk];
+     }
+};
+
+template <>
+inline const std::vector<CommandBuffer::Heal> &CommandBuffer::Chunk::get_list<CommandBuffer::Heal>() const { return heal_list; }
+template <>
+inline const std::vector<CommandBuffer::ApplyDamage> &CommandBuffer::Chunk::get_list<CommandBuffer::ApplyDamage>() const { return apply_damage_list; }
+template <>
+inline const std::vector<CommandBuffer::SpawnCoin> &CommandBuffer::Chunk::get_list<CommandBuffer::SpawnCoin>() const { return spawn_coin_list; }
+template <>
+inline const std::vector<CommandBuffer::SpawnBullet> &CommandBuffer::Chunk::get_list<CommandBuffer::SpawnBullet>() const { return spawn_bullet_list; }
+template <>
+inline const std::vector<CommandBuffer::PlaySound> &CommandBuffer::Chunk::get_list<CommandBuffer::PlaySound>() const { return play_sound_list; }
+
+#endif // !_COMMAND_BUFFER_H_
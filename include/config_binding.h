@@ -0,0 +1,455 @@
+#ifndef _CONFIG_BINDING_H_
+#define _CONFIG_BINDING_H_
+
+#include <cJSON.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cfloat>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+/**
+ * @brief 配置字段类型
+ */
+enum class ConfigFieldType
+{
+     Number,      // double
+     Integer,     // int，JSON中的数字必须是整数
+     Boolean,     // bool
+     String,      // std::string
+     NumberArray, // double[N]，元素个数不能超过N，未给出的元素保持默认值
+     Enum,        // 枚举，JSON中为字符串，通过名称表转换
+     Object,      // 嵌套结构体，使用嵌套字段表
+     ObjectList   // std::vector<结构体>，JSON中为对象数组
+};
+
+/**
+ * @brief 枚举名称表项
+ */
+struct ConfigEnumName
+{
+     const char *name; // JSON中的字符串
+     int value;        // 对应的枚举值
+};
+
+/**
+ * @brief 配置中的位置，只在出错时格式化为 "tower.archer.damage[3]" 形式的字符串
+ *
+ * 以链表形式挂在调用栈上，解析成功时不产生任何字符串分配。
+ */
+struct ConfigPath
+{
+     const ConfigPath *parent = nullptr; // 上一级位置
+     const char *key = nullptr;          // 对象中的键，数组元素为nullptr
+     int index = -1;                     // 数组下标，对象成员为-1
+
+     std::string to_string() const
+     {
+          std::string str = parent ? parent->to_string() : std::string();
+          if (key)
+          {
+               if (!str.empty())
+                    str += '.';
+               str += key;
+          }
+          else if (index >= 0)
+               str += "[" + std::to_string(index) + "]";
+
+          return str;
+     }
+};
+
+/**
+ * @brief 字段描述：把JSON中的一个键绑定到结构体T的一个成员上
+ *
+ * 字段表是constexpr数组，由下面的config_field等辅助函数从成员指针生成，
+ * 成员类型在编译期推导，和声明的类型不一致时无法通过编译。
+ * 字段表只描述"有哪些字段、类型、取值范围、如何定位"，与JSON无关，
+ * 之后的二进制配置格式可以直接复用同一份字段表读写。
+ */
+template <typename T>
+struct ConfigField
+{
+     const char *name = nullptr;                                                                        // JSON中的键
+     ConfigFieldType type = ConfigFieldType::Number;                                                    // 字段类型
+     void *(*locate)(T &) = nullptr;                                                                    // 返回成员在对象中的地址
+     size_t length = 1;                                                                                 // 数组容量，其他类型为1
+     double value_min = -DBL_MAX;                                                                       // 数值下限（含）
+     double value_max = DBL_MAX;                                                                        // 数值上限（含）
+     bool is_required = false;                                                                          // 是否必须出现
+     const ConfigEnumName *enum_name_list = nullptr;                                                    // 枚举名称表
+     size_t num_enum_name = 0;                                                                          // 枚举名称表长度
+     void (*assign_enum)(void *, int) = nullptr;                                                        // 把整数写入枚举成员
+     bool (*bind_nested)(const cJSON *, void *, const ConfigPath &, std::string &) = nullptr;            // 解析嵌套对象或对象数组
+};
+
+/**
+ * @brief 从成员指针类型中取出所属结构体和成员类型
+ */
+template <typename>
+struct ConfigMemberTraits;
+
+template <typename C, typename M>
+struct ConfigMemberTraits<M C::*>
+{
+     typedef C Class;
+     typedef M Member;
+};
+
+template <auto member>
+using ConfigMemberClass = typename ConfigMemberTraits<decltype(member)>::Class;
+
+template <auto member>
+using ConfigMemberType = typename ConfigMemberTraits<decltype(member)>::Member;
+
+template <auto member>
+void *config_locate(ConfigMemberClass<member> &obj)
+{
+     return &(obj.*member);
+}
+
+template <typename E>
+void config_assign_enum(void *dst, int value)
+{
+     *(E *)dst = (E)value;
+}
+
+template <typename>
+struct ConfigUnsupported : std::false_type
+{
+};
+
+/**
+ * @brief 生成基本类型字段：double、int、bool、std::string 或 double[N]
+ * @tparam member 成员指针，例如 &EnemyTemplate::hp
+ * @param name JSON中的键
+ * @param value_min 数值下限，对数组逐元素检查
+ * @param value_max 数值上限，对数组逐元素检查
+ */
+template <auto member>
+constexpr ConfigField<ConfigMemberClass<member>> config_field(const char *name, double value_min = -DBL_MAX, double value_max = DBL_MAX)
+{
+     typedef ConfigMemberType<member> M;
+
+     ConfigField<ConfigMemberClass<member>> field;
+     field.name = name;
+     field.locate = &config_locate<member>;
+     field.value_min = value_min;
+     field.value_max = value_max;
+
+     if constexpr (std::is_same<M, double>::value)
+          field.type = ConfigFieldType::Number;
+     else if constexpr (std::is_same<M, int>::value)
+          field.type = ConfigFieldType::Integer;
+     else if constexpr (std::is_same<M, bool>::value)
+          field.type = ConfigFieldType::Boolean;
+     else if constexpr (std::is_same<M, std::string>::value)
+          field.type = ConfigFieldType::String;
+     else if constexpr (std::is_array<M>::value && std::is_same<typename std::remove_extent<M>::type, double>::value)
+     {
+          field.type = ConfigFieldType::NumberArray;
+          field.length = std::extent<M>::value;
+     }
+     else
+          static_assert(ConfigUnsupported<M>::value, "unsupported config field type");
+
+     return field;
+}
+
+/**
+ * @brief 生成枚举字段，JSON中的字符串按名称表转换为枚举值
+ * @tparam member 枚举成员指针
+ * @tparam name_list 枚举名称表
+ * @param name JSON中的键
+ */
+template <auto member, const auto &name_list>
+constexpr ConfigField<ConfigMemberClass<member>> config_enum(const char *name)
+{
+     static_assert(std::is_enum<ConfigMemberType<member>>::value, "config_enum requires an enum member");
+
+     ConfigField<ConfigMemberClass<member>> field;
+     field.name = name;
+     field.type = ConfigFieldType::Enum;
+     field.locate = &config_locate<member>;
+     field.enum_name_list = name_list;
+     field.num_enum_name = std::extent<typename std::remove_reference<decltype(name_list)>::type>::value;
+     field.assign_enum = &config_assign_enum<ConfigMemberType<member>>;
+
+     return field;
+}
+
+template <typename T, size_t N>
+bool config_bind_object(const cJSON *json, T &dst, const ConfigField<T> (&field_list)[N], const ConfigPath &path, std::string &error);
+
+template <typename T, size_t N>
+bool config_bind_list(const cJSON *json, std::vector<T> &dst, const ConfigField<T> (&field_list)[N], const ConfigPath &path, std::string &error);
+
+template <typename T, const auto &field_list>
+bool config_bind_nested_object(const cJSON *json, void *dst, const ConfigPath &path, std::string &error)
+{
+     return config_bind_object(json, *(T *)dst, field_list, path, error);
+}
+
+template <typename T, const auto &field_list>
+bool config_bind_nested_list(const cJSON *json, void *dst, const ConfigPath &path, std::string &error)
+{
+     return config_bind_list(json, *(std::vector<T> *)dst, field_list, path, error);
+}
+
+/**
+ * @brief 生成嵌套对象字段
+ * @tparam member 结构体成员指针
+ * @tparam field_list 嵌套结构体的字段表
+ * @param name JSON中的键
+ * @param is_required 是否必须出现
+ */
+template <auto member, const auto &field_list>
+constexpr ConfigField<ConfigMemberClass<member>> config_object(const char *name, bool is_required = false)
+{
+     ConfigField<ConfigMemberClass<member>> field;
+     field.name = name;
+     field.type = ConfigFieldType::Object;
+     field.locate = &config_locate<member>;
+     field.is_required = is_required;
+     field.bind_nested = &config_bind_nested_object<ConfigMemberType<member>, field_list>;
+
+     return field;
+}
+
+/**
+ * @brief 生成对象数组字段，成员类型为 std::vector<结构体>
+ * @tparam member 数组成员指针
+ * @tparam field_list 数组元素的字段表
+ * @param name JSON中的键
+ * @param is_required 是否必须出现
+ */
+template <auto member, const auto &field_list>
+constexpr ConfigField<ConfigMemberClass<member>> config_list(const char *name, bool is_required = false)
+{
+     ConfigField<ConfigMemberClass<member>> field;
+     field.name = name;
+     field.type = ConfigFieldType::ObjectList;
+     field.locate = &config_locate<member>;
+     field.is_required = is_required;
+     field.bind_nested = &config_bind_nested_list<typename ConfigMemberType<member>::value_type, field_list>;
+
+     return field;
+}
+
+inline const char *config_json_type_name(const cJSON *json)
+{
+     switch (json->type & 0xFF)
+     {
+     case cJSON_False:
+     case cJSON_True:
+          return "boolean";
+     case cJSON_NULL:
+          return "null";
+     case cJSON_Number:
+          return "number";
+     case cJSON_String:
+          return "string";
+     case cJSON_Array:
+          return "array";
+     case cJSON_Object:
+          return "object";
+     default:
+          return "invalid value";
+     }
+}
+
+inline bool config_set_error(const ConfigPath &path, const std::string &message, std::string &error)
+{
+     std::string str_path = path.to_string();
+     error = str_path.empty() ? message : str_path + ": " + message;
+     return false;
+}
+
+inline bool config_check_range(double value, double value_min, double value_max, const ConfigPath &path, std::string &error)
+{
+     if (value >= value_min && value <= value_max)
+          return true;
+
+     char str_message[128];
+     std::snprintf(str_message, sizeof(str_message), "%g is out of range [%g, %g]", value, value_min, value_max);
+     return config_set_error(path, str_message, error);
+}
+
+/**
+ * @brief 按字段描述解析一个JSON值并写入目标对象
+ */
+template <typename T>
+bool config_bind_field(const cJSON *json, T &dst, const ConfigField<T> &field, const ConfigPath &path, std::string &error)
+{
+     void *ptr = field.locate(dst);
+     int type = json->type & 0xFF;
+
+     switch (field.type)
+     {
+     case ConfigFieldType::Number:
+     case ConfigFieldType::Integer:
+          if (type != cJSON_Number)
+               return config_set_error(path, std::string("expected number, got ") + config_json_type_name(json), error);
+          if (!config_check_range(json->valuedouble, field.value_min, field.value_max, path, error))
+               return false;
+          if (field.type == ConfigFieldType::Number)
+          {
+               *(double *)ptr = json->valuedouble;
+               return true;
+          }
+          if (json->valuedouble != std::floor(json->valuedouble) || std::abs(json->valuedouble) > INT32_MAX)
+          {
+               char str_message[64];
+               std::snprintf(str_message, sizeof(str_message), "expected integer, got %g", json->valuedouble);
+               return config_set_error(path, str_message, error);
+          }
+          *(int *)ptr = (int)json->valuedouble;
+          return true;
+
+     case ConfigFieldType::Boolean:
+          if (type != cJSON_True && type != cJSON_False)
+               return config_set_error(path, std::string("expected boolean, got ") + config_json_type_name(json), error);
+          *(bool *)ptr = type == cJSON_True;
+          return true;
+
+     case ConfigFieldType::String:
+          if (type != cJSON_String)
+               return config_set_error(path, std::string("expected string, got ") + config_json_type_name(json), error);
+          *(std::string *)ptr = json->valuestring;
+          return true;
+
+     case ConfigFieldType::NumberArray:
+     {
+          if (type != cJSON_Array)
+               return config_set_error(path, std::string("expected array, got ") + config_json_type_name(json), error);
+
+          // 先检查全部元素再写入，出错时目标保持不变
+          int idx = 0;
+          const cJSON *json_element = nullptr;
+          cJSON_ArrayForEach(json_element, json)
+          {
+               ConfigPath path_element = {&path, nullptr, idx};
+               if ((size_t)idx >= field.length)
+                    return config_set_error(path, "array has more than " + std::to_string(field.length) + " elements", error);
+               if ((json_element->type & 0xFF) != cJSON_Number)
+                    return config_set_error(path_element, std::string("expected number, got ") + config_json_type_name(json_element), error);
+               if (!config_check_range(json_element->valuedouble, field.value_min, field.value_max, path_element, error))
+                    return false;
+               idx++;
+          }
+
+          idx = 0;
+          cJSON_ArrayForEach(json_element, json)
+               ((double *)ptr)[idx++] = json_element->valuedouble;
+          return true;
+     }
+
+     case ConfigFieldType::Enum:
+     {
+          if (type != cJSON_String)
+               return config_set_error(path, std::string("expected string, got ") + config_json_type_name(json), error);
+
+          for (size_t i = 0; i < field.num_enum_name; i++)
+          {
+               if (std::strcmp(field.enum_name_list[i].name, json->valuestring) == 0)
+               {
+                    field.assign_enum(ptr, field.enum_name_list[i].value);
+                    return true;
+               }
+          }
+
+          std::string str_name_list;
+          for (size_t i = 0; i < field.num_enum_name; i++)
+               str_name_list += (i > 0 ? ", " : "") + std::string(field.enum_name_list[i].name);
+          return config_set_error(path, "unknown value \"" + std::string(json->valuestring) + "\", expected one of: " + str_name_list, error);
+     }
+
+     case ConfigFieldType::Object:
+     case ConfigFieldType::ObjectList:
+          return field.bind_nested(json, ptr, path, error);
+     }
+
+     return config_set_error(path, "unsupported field type", error);
+}
+
+/**
+ * @brief 按字段表解析一个JSON对象
+ *
+ * 只遍历一遍对象的成员，每个键在字段表中查找对应字段；
+ * 未知的键、类型不符、超出范围和缺少必需字段都会报错，错误信息包含完整的字段路径。
+ * 解析失败时目标对象可能已被部分写入，调用者应解析到临时对象上，成功后再替换。
+ *
+ * @param json JSON对象
+ * @param dst 目标结构体
+ * @param field_list 字段表
+ * @param path 该对象在配置中的位置
+ * @param error 输出：错误信息
+ * @return 是否成功
+ */
+template <typename T, size_t N>
+bool config_bind_object(const cJSON *json, T &dst, const ConfigField<T> (&field_list)[N], const ConfigPath &path, std::string &error)
+{
+     static_assert(N <= 64, "config field table is limited to 64 fields");
+
+     if (!json || (json->type & 0xFF) != cJSON_Object)
+          return config_set_error(path, std::string("expected object, got ") + (json ? config_json_type_name(json) : "nothing"), error);
+
+     uint64_t mask_found = 0;
+     const cJSON *json_member = nullptr;
+     cJSON_ArrayForEach(json_member, json)
+     {
+          ConfigPath path_member = {&path, json_member->string, -1};
+
+          size_t idx_field = 0;
+          while (idx_field < N && std::strcmp(field_list[idx_field].name, json_member->string) != 0)
+               idx_field++;
+          if (idx_field == N)
+               return config_set_error(path_member, "unknown field", error);
+
+          if (!config_bind_field(json_member, dst, field_list[idx_field], path_member, error))
+               return false;
+          mask_found |= (uint64_t)1 << idx_field;
+     }
+
+     for (size_t i = 0; i < N; i++)
+     {
+          if (field_list[i].is_required && !(mask_found & ((uint64_t)1 << i)))
+               return config_set_error(path, std::string("missing required field \"") + field_list[i].name + "\"", error);
+     }
+
+     return true;
+}
+
+/**
+ * @brief 按字段表解析一个JSON对象数组，结果追加到目标数组末尾
+ * @param json JSON数组
+ * @param dst 目标数组
+ * @param field_list 数组元素的字段表
+ * @param path 该数组在配置中的位置
+ * @param error 输出：错误信息
+ * @return 是否成功
+ */
+template <typename T, size_t N>
+bool config_bind_list(const cJSON *json, std::vector<T> &dst, const ConfigField<T> (&field_list)[N], const ConfigPath &path, std::string &error)
+{
+     if (!json || (json->type & 0xFF) != cJSON_Array)
+          return config_set_error(path, std::string("expected array, got ") + (json ? config_json_type_name(json) : "nothing"), error);
+
+     int idx = 0;
+     const cJSON *json_element = nullptr;
+     cJSON_ArrayForEach(json_element, json)
+     {
+          ConfigPath path_element = {&path, nullptr, idx++};
+          dst.emplace_back();
+          if (!config_bind_object(json_element, dst.back(), field_list, path_element, error))
+               return false;
+     }
+
+     return true;
+}
+
+#endif // !_CONFIG_BINDING_H_
@@ -3,15 +3,21 @@
 
 #include "timer.h"
 #include "game_map/route.h"
+#include "game_map/flow_field.h"
 #include "game_map/vector2.h"
 #include "animation.h"
+#include "camera.h"
 #include "manager/config_manager.h"
+#include "enemy/enemy_type.h"
 
+#include <limits>
+#include <algorithm>
 #include <functional>
 
 // 敌人类：游戏中的敌人实体
 // 功能包括：
-// 1. 沿指定路径移动：敌人会按照预设的路径点进行移动，支持平滑过渡
+// 1. 沿指定路径移动：敌人只记录沿路径走过的距离，位置和方向由路径的预计算表查询；
+//    自由寻路模式下改为按共享的流场逐个瓦片走向终点
 // 2. 生命值管理：包含最大生命值、当前生命值，以及生命值变化时的视觉效果
 // 3. 技能系统：支持定时释放技能，可自定义技能效果
 // 4. 动画状态管理：根据移动方向和状态（正常/受伤）切换不同的动画
@@ -56,30 +62,28 @@ public:
      // @param delta: 时间增量，单位：秒
      // 功能：
      // 1. 更新所有计时器状态
-     // 2. 计算并更新敌人位置
-     // 3. 处理路径点切换
-     // 4. 更新速度向量
-     // 5. 根据移动方向和状态选择并更新动画
+     // 2. 沿路径前进，由路径的弧长表查询位置和方向
+     // 3. 更新速度向量
+     // 4. 根据移动方向和状态选择并更新动画
      void on_update(double delta)
      {
+          time_alive += delta;
+
           // 更新所有计时器
           timer_skill.on_update(delta);
           timer_sketch.on_update(delta);
           timer_restore_speed.on_update(delta);
 
-          // 计算移动距离和目标距离
-          Vector2 move_distance = velocity * delta;
-          Vector2 target_distance = position_target - position;
-          // 移动敌人，确保不会超过目标位置
-          position += move_distance < target_distance ? move_distance : target_distance;
-
-          // 如果到达目标点，更新下一个目标点
-          if (target_distance.approx_zero())
+          if (flow_field)
           {
-               idx_target++;
-               refresh_position_target();
-
-               direction = (position_target - position).normalize();
+               // 按流场前进，到达终点后停在终点
+               move_by_flow_field(speed * SIZE_TILE * delta);
+          }
+          else
+          {
+               // 沿路径前进，到达终点后停在终点
+               distance_route = std::min(distance_route + speed * SIZE_TILE * delta, route->get_length());
+               refresh_position();
           }
 
           // 更新速度向量：速度 = 方向 * 速度值 * 瓦片大小
@@ -112,12 +116,13 @@ public:
      }
 
      // 渲染敌人
-     // @param renderer: SDL渲染器
+     // @param snapshot: 渲染快照
+     // @param camera: 摄像机，用于视锥裁剪和坐标转换
      // 功能：
      // 1. 渲染当前动画帧
      // 2. 如果生命值不满，渲染血条
      // 3. 血条包含边框和内容两部分，内容长度根据当前生命值比例计算
-     void on_render(SDL_Renderer *renderer)
+     void on_render(RenderSnapshot &snapshot, const Camera &camera)
      {
           // 静态变量定义
           static SDL_Rect rect;
@@ -127,28 +132,31 @@ public:
           static const SDL_Color color_border = {116, 185, 124, 255};  // 血条边框颜色
           static const SDL_Color color_content = {226, 255, 194, 255}; // 血条内容颜色
 
+          // 视锥裁剪：血条位于敌人上方，裁剪范围向上下各扩展一个血条高度
+          if (!camera.is_visible(position, size + Vector2(0, (size_hp_bar.y + offset_y) * 2)))
+               return;
+
           // 计算渲染位置（居中显示）
-          point.x = (int)(position.x - size.x / 2);
-          point.y = (int)(position.y - size.y / 2);
+          const Vector2 pos_view = camera.world_to_view(position);
+          point.x = (int)(pos_view.x - size.x / 2);
+          point.y = (int)(pos_view.y - size.y / 2);
 
           // 渲染当前动画
-          anim_current->on_render(renderer, point);
+          anim_current->on_render(snapshot, point);
 
           // 如果生命值不满，渲染血条
           if (hp < max_hp)
           {
                // 渲染血条内容（绿色填充）
-               rect.x = (int)(position.x - size_hp_bar.x / 2);
-               rect.y = (int)(position.y - size.y / 2 - size_hp_bar.y - offset_y);
+               rect.x = (int)(pos_view.x - size_hp_bar.x / 2);
+               rect.y = (int)(pos_view.y - size.y / 2 - size_hp_bar.y - offset_y);
                rect.w = (int)(size_hp_bar.x * (hp / max_hp)); // 根据生命值比例计算宽度
                rect.h = (int)size_hp_bar.y;
-               SDL_SetRenderDrawColor(renderer, color_content.r, color_content.g, color_content.b, color_content.a);
-               SDL_RenderFillRect(renderer, &rect);
+               snapshot.fill_rect(rect, color_content);
 
                // 渲染血条边框（深绿色）
                rect.w = (int)size_hp_bar.x;
-               SDL_SetRenderDrawColor(renderer, color_border.r, color_border.g, color_border.b, color_border.a);
-               SDL_RenderDrawRect(renderer, &rect);
+               snapshot.draw_rect(rect, color_border);
           }
      }
 
@@ -218,12 +226,34 @@ public:
      // @param route: 新的路径
      // 功能：
      // 1. 更新路径
-     // 2. 刷新目标位置
+     // 2. 从路径起点开始移动
      void set_route(const Route *route)
      {
           this->route = route;
 
-          refresh_position_target();
+          distance_route = 0;
+          idx_segment = 0;
+          refresh_position();
+     }
+
+     // 设置自由寻路使用的流场
+     // @param flow_field: 所有敌人共享的流场
+     // @param idx_origin: 出发瓦片坐标
+     // 功能：
+     // 1. 把敌人放到出发瓦片的中心
+     // 2. 之后每次到达瓦片中心时按流向选择下一个瓦片
+     void set_flow_field(const FlowField *flow_field, const SDL_Point &idx_origin)
+     {
+          static const SDL_Rect &rect_tile_map = ConfigManager::instance()->rect_tile_map;
+
+          this->flow_field = flow_field;
+          version_flow_field = flow_field->get_version();
+
+          const SDL_Point pos_origin = Tile::get_pos_by_idx(idx_origin, rect_tile_map);
+          position = Vector2(pos_origin.x, pos_origin.y);
+          idx_tile_next = idx_origin;
+
+          distance_to_home_origin = get_distance_to_home();
      }
 
      // 使敌人失效
@@ -263,6 +293,25 @@ public:
           return damage;
      }
 
+     // 设置敌人类型，由EnemyManager在生成时调用
+     // @param type: 敌人类型
+     void set_enemy_type(EnemyType type)
+     {
+          enemy_type = type;
+     }
+
+     // 获取敌人类型
+     EnemyType get_enemy_type() const
+     {
+          return enemy_type;
+     }
+
+     // 获取从生成到现在经过的时间（秒）
+     double get_time_alive() const
+     {
+          return time_alive;
+     }
+
      // 获取奖励倍率
      double get_reward_ratio() const
      {
@@ -290,13 +339,28 @@ public:
      }
 
      // 获取路径进度
-     // 返回：当前路径的完成进度（0-1之间的小数）
+     // 返回：当前路径的完成进度（0-1之间的小数），按走过的弧长计算，同一路径上的敌人可精确排序
      double get_route_process() const
      {
-          if (route->get_idx_list().size() == 1)
+          double length = flow_field ? distance_to_home_origin : route->get_length();
+          if (length <= 0 || length == std::numeric_limits<double>::max())
                return 1;
 
-          return (double)idx_target / (route->get_idx_list().size() - 1);
+          return 1 - get_distance_to_home() / length;
+     }
+
+     // 获取到终点的剩余距离（像素），不同路径上的敌人也可以直接比较
+     // 返回：剩余距离，自由寻路模式下无法到达终点时返回double的最大值
+     double get_distance_to_home() const
+     {
+          if (!flow_field)
+               return route->get_length() - distance_route;
+
+          int cost = flow_field->get_cost(idx_tile_next);
+          if (cost == FlowField::cost_unreachable)
+               return std::numeric_limits<double>::max();
+
+          return cost * SIZE_TILE + (get_tile_center(idx_tile_next) - position).length();
      }
 
 protected:
@@ -330,7 +394,9 @@ private:
      Vector2 velocity;  // 当前速度向量
      Vector2 direction; // 当前移动方向
 
-     bool is_valid = true; // 敌人是否有效
+     bool is_valid = true;                   // 敌人是否有效
+     EnemyType enemy_type = EnemyType::Slim; // 敌人类型
+     double time_alive = 0;                  // 从生成到现在经过的时间（秒）
 
      Timer timer_sketch;          // 受伤闪烁计时器
      bool is_show_sketch = false; // 是否显示受伤闪烁效果
@@ -342,26 +408,78 @@ private:
      Timer timer_restore_speed; // 减速恢复计时器
 
      const Route *route = nullptr; // 当前移动路径
-     int idx_target = 0;           // 当前目标路径点索引
-     Vector2 position_target;      // 当前目标位置
+     double distance_route = 0;    // 沿路径走过的距离（像素）
+     size_t idx_segment = 0;       // 当前所在的路径线段索引
+
+     const FlowField *flow_field = nullptr; // 自由寻路模式下使用的流场，为空时沿固定路径移动
+     SDL_Point idx_tile_next = {0};         // 自由寻路模式下正在前往的瓦片
+     uint32_t version_flow_field = 0;       // 选择idx_tile_next时的流场版本
+     double distance_to_home_origin = 0;    // 自由寻路模式下出发时到终点的距离，用于计算进度
 
 private:
-     // 刷新目标位置
+     // 根据走过的距离刷新位置和移动方向
      // 功能：
-     // 1. 根据当前路径点索引获取目标位置
-     // 2. 将路径点坐标转换为实际像素坐标
-     void refresh_position_target()
+     // 1. 从上次所在的线段向前查找当前线段
+     // 2. 由路径的预计算表得到位置（相对地图左上角），再转换为世界坐标
+     void refresh_position()
      {
-          const Route::IdxList &idx_list = route->get_idx_list();
+          static const SDL_Rect &rect_tile_map = ConfigManager::instance()->rect_tile_map;
+
+          route->locate_segment(distance_route, idx_segment);
 
-          if (idx_target < idx_list.size())
+          position = route->get_position(distance_route, idx_segment);
+          position.x += rect_tile_map.x;
+          position.y += rect_tile_map.y;
+
+          direction = route->get_direction(idx_segment);
+     }
+
+     // 获取瓦片中心的世界坐标
+     // @param idx: 瓦片坐标
+     static Vector2 get_tile_center(const SDL_Point &idx)
+     {
+          static const SDL_Rect &rect_tile_map = ConfigManager::instance()->rect_tile_map;
+
+          const SDL_Point pos = Tile::get_pos_by_idx(idx, rect_tile_map);
+          return Vector2(pos.x, pos.y);
+     }
+
+     // 按流场移动
+     // @param distance: 本帧移动的距离（像素）
+     // 功能：
+     // 1. 流场更新后，从当前所在的瓦片重新选择路线
+     // 2. 朝正在前往的瓦片中心移动，到达后按流向选择下一个瓦片，剩余距离继续移动
+     // 3. 位于终点或无路可走时停在原地
+     void move_by_flow_field(double distance)
+     {
+          static const SDL_Rect &rect_tile_map = ConfigManager::instance()->rect_tile_map;
+
+          if (version_flow_field != flow_field->get_version())
           {
-               const SDL_Point &point = idx_list[idx_target];
-               static const SDL_Rect &rect_tile_map = ConfigManager::instance()->rect_tile_map;
+               version_flow_field = flow_field->get_version();
+               idx_tile_next.x = (int)((position.x - rect_tile_map.x) / SIZE_TILE);
+               idx_tile_next.y = (int)((position.y - rect_tile_map.y) / SIZE_TILE);
+          }
 
-               // 计算目标位置（瓦片中心点）
-               position_target.x = rect_tile_map.x + point.x * SIZE_TILE + SIZE_TILE / 2;
-               position_target.y = rect_tile_map.y + point.y * SIZE_TILE + SIZE_TILE / 2;
+          while (true)
+          {
+               Vector2 offset = get_tile_center(idx_tile_next) - position;
+               double distance_target = offset.length();
+               if (distance_target > distance)
+               {
+                    direction = offset.normalize();
+                    position += direction * distance;
+                    return;
+               }
+
+               position += offset;
+               distance -= distance_target;
+
+               Tile::Direction direction_next = flow_field->get_direction(idx_tile_next);
+               if (direction_next == Tile::Direction::None)
+                    return;
+
+               idx_tile_next = FlowField::get_neighbor(idx_tile_next, direction_next);
           }
      }
 };
@@ -0,0 +1,222 @@
+#ifndef _EVENT_BUS_H_
+#define _EVENT_BUS_H_
+
+#include "manager/manager.h"
+#include "game_map/vector2.h"
+#include "enemy/enemy_type.h"
+#include "tower/tower_type.h"
+#include "command_buffer.h"
+
+#include <SDL.h>
+#include <tuple>
+#include <vector>
+
+// 敌人被击杀
+struct EnemyKilledEvent
+{
+     EnemyType type = EnemyType::Slim; // 敌人类型
+     Vector2 position;                 // 死亡位置
+     TowerHandle tower_source;         // 造成致命伤害的防御塔，空句柄表示玩家或其他来源
+     double time_alive = 0;            // 从生成到被击杀经过的时间（秒）
+};
+
+// 敌人到达终点
+struct EnemyReachedHomeEvent
+{
+     EnemyType type = EnemyType::Slim; // 敌人类型
+     double damage = 0;                // 对基地造成的伤害
+};
+
+// 防御塔开火（瞬间命中武器也会发布）
+struct BulletFiredEvent
+{
+     TowerType tower_type = TowerType::Archer; // 防御塔类型
+     TowerHandle tower_source;                 // 开火的防御塔
+     Vector2 position;                         // 开火位置
+};
+
+// 防御塔造成伤害（一条伤害指令结算后发布一次）
+struct TowerDamageEvent
+{
+     TowerType tower_type = TowerType::Archer; // 防御塔类型
+     TowerHandle tower_source;                 // 造成伤害的防御塔
+     double damage = 0;                        // 实际造成的伤害
+     int num_kill = 0;                         // 击杀数
+};
+
+// 放置防御塔
+struct TowerPlacedEvent
+{
+     TowerType type = TowerType::Archer; // 防御塔类型
+     SDL_Point idx_tile = {0, 0};        // 所在瓦片
+     double cost = 0;                    // 放置成本
+};
+
+// 出售防御塔
+struct TowerSoldEvent
+{
+     TowerType type = TowerType::Archer; // 防御塔类型
+     SDL_Point idx_tile = {0, 0};        // 原来所在的瓦片
+     double refund = 0;                  // 返还的金币
+};
+
+// 迁移防御塔
+struct TowerRelocatedEvent
+{
+     TowerType type = TowerType::Archer; // 防御塔类型
+     SDL_Point idx_tile_src = {0, 0};    // 原来所在的瓦片
+     SDL_Point idx_tile_dst = {0, 0};    // 迁移后所在的瓦片
+};
+
+// 升级防御塔，全局升级时瓦片为{-1, -1}
+struct TowerUpgradedEvent
+{
+     TowerType type = TowerType::Archer; // 防御塔类型
+     SDL_Point idx_tile = {-1, -1};      // 单独升级的塔所在的瓦片
+     int level = 0;                      // 升级后的等级
+};
+
+// 放置或迁移防御塔被拒绝（会阻断某个生成点到终点的路线）
+struct TowerPlaceRejectedEvent
+{
+     SDL_Point idx_tile = {0, 0}; // 目标瓦片
+};
+
+// 波次开始
+struct WaveStartedEvent
+{
+     int idx_wave = 0; // 波次索引
+};
+
+// 拾取金币
+struct CoinPickedEvent
+{
+     Vector2 position; // 金币位置
+     double value = 0; // 金币数量
+};
+
+// 事件总线：模拟中发布游戏事件，每帧在同步点之后统一分发给订阅者
+// 音效、统计、界面等只需订阅关心的事件，不再由产生事件的系统直接调用
+// 功能包括：
+// 1. 类型化：每种事件有独立的队列和订阅者列表，发布和订阅在编译期确定队列，没有查找开销
+// 2. 零分配：队列预先分配容量，分发时交换双缓冲并保留容量，稳定运行时不再分配内存；
+//    订阅者为函数指针加上下文指针，分发时不经过std::function
+// 3. 延迟分发：发布只是追加到队列，热路径上没有回调开销；分发期间发布的事件留到下一帧
+// 只能在串行代码中发布（并行区域内的副作用应写入CommandBuffer，在同步点发布）
+class EventBus : public Manager<EventBus>
+{
+     friend class Manager<EventBus>;
+
+public:
+     // 事件处理函数
+     // @param context: 订阅时传入的上下文指针
+     // @param event: 事件
+     template <typename Event>
+     using Handler = void (*)(void *context, const Event &event);
+
+public:
+     // 订阅某种事件，一般在初始化时调用
+     // @param handler: 处理函数（可以是不捕获变量的lambda）
+     // @param context: 原样传给处理函数的上下文指针
+     template <typename Event>
+     void subscribe(Handler<Event> handler, void *context = nullptr)
+     {
+          get_channel<Event>().subscriber_list.push_back({handler, context});
+     }
+
+     // 发布事件，在下一次dispatch时分发
+     // @param event: 事件
+     template <typename Event>
+     void publish(const Event &event)
+     {
+          get_channel<Event>().event_list.push_back(event);
+     }
+
+     // 按事件类型依次分发队列中的所有事件，每帧调用一次
+     void dispatch()
+     {
+          std::apply([](auto &...channel)
+                     { (channel.dispatch(), ...); },
+                     channel_list);
+     }
+
+     // 丢弃所有未分发的事件
+     void clear()
+     {
+          std::apply([](auto &...channel)
+                     { (channel.event_list.clear(), ...); },
+                     channel_list);
+     }
+
+protected:
+     EventBus()
+     {
+          std::apply([](auto &...channel)
+                     { (channel.reserve(capacity_initial), ...); },
+                     channel_list);
+     }
+
+     ~EventBus() = default;
+
+private:
+     // 单种事件的订阅者
+     template <typename Event>
+     struct Subscriber
+     {
+          Handler<Event> handler;
+          void *context;
+     };
+
+     // 单种事件的队列和订阅者
+     template <typename Event>
+     struct Channel
+     {
+          std::vector<Event> event_list;                  // 本帧发布的事件
+          std::vector<Event> event_list_dispatch;         // 正在分发的事件，与event_list交换
+          std::vector<Subscriber<Event>> subscriber_list; // 订阅者
+
+          void reserve(size_t capacity)
+          {
+               event_list.reserve(capacity);
+               event_list_dispatch.reserve(capacity);
+          }
+
+          void dispatch()
+          {
+               if (event_list.empty())
+                    return;
+
+               // 交换后再分发，处理函数中发布的同类事件进入新的队列，不会使正在遍历的队列失效
+               event_list_dispatch.swap(event_list);
+               for (const Event &event : event_list_dispatch)
+                    for (const Subscriber<Event> &subscriber : subscriber_list)
+                         subscriber.handler(subscriber.context, event);
+               event_list_dispatch.clear();
+          }
+     };
+
+private:
+     static constexpr size_t capacity_initial = 256; // 每种事件队列的初始容量
+
+     std::tuple<Channel<EnemyKilledEvent>,
+                Channel<EnemyReachedHomeEvent>,
+                Channel<BulletFiredEvent>,
+                Channel<TowerDamageEvent>,
+                Channel<TowerPlacedEvent>,
+                Channel<TowerSoldEvent>,
+                Channel<TowerRelocatedEvent>,
+                Channel<TowerUpgradedEvent>,
+                Channel<TowerPlaceRejectedEvent>,
+                Channel<WaveStartedEvent>,
+                Channel<CoinPickedEvent>>
+         channel_list; // 所有事件的队列，按类型取出
+
+private:
+     template <typename Event>
+     Channel<Event> &get_channel()
+     {
+          return std::get<Channel<Event>>(channel_list);
+     }
+};
+
+#endif // !_EVENT_BUS_H_
@@ -0,0 +1,211 @@
+#ifndef _FILE_WATCHER_H_
+#define _FILE_WATCHER_H_
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <filesystem>
+#include <system_error>
+
+#ifdef __linux__
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#endif
+
+/**
+ * @brief 文件监视器：在后台线程中监视一组文件，文件被修改后回调
+ *
+ * Linux上使用inotify监视文件所在的目录（编辑器常用"写临时文件再重命名"的方式保存，
+ * 直接监视文件本身会在重命名后失效），其他平台或inotify不可用时退化为定期比较修改时间。
+ * 保存操作往往触发多个事件，收到事件后会等待一小段时间合并，同一文件只回调一次。
+ * 回调在后台线程中执行。
+ */
+class FileWatcher
+{
+public:
+     typedef std::function<void(const std::string &path)> Callback;
+
+public:
+     FileWatcher() = default;
+
+     ~FileWatcher()
+     {
+          stop();
+     }
+
+     FileWatcher(const FileWatcher &) = delete;
+     FileWatcher &operator=(const FileWatcher &) = delete;
+
+     /**
+      * @brief 添加要监视的文件，需在start之前调用
+      * @param path 文件路径
+      */
+     void add(const std::string &path)
+     {
+          WatchedFile file;
+          file.path = path;
+          std::filesystem::path fs_path(path);
+          file.dir = fs_path.has_parent_path() ? fs_path.parent_path().string() : ".";
+          file.name = fs_path.filename().string();
+          file_list.push_back(file);
+     }
+
+     /**
+      * @brief 启动后台监视线程
+      * @param on_change 文件变化时的回调，参数为add时传入的路径
+      * @param poll_interval 退化为轮询时的检查间隔（秒）
+      */
+     void start(Callback on_change, double poll_interval = 0.5)
+     {
+          stop();
+
+          this->on_change = on_change;
+          this->poll_interval = poll_interval;
+          is_running = true;
+          thread_watch = std::thread(&FileWatcher::run, this);
+     }
+
+     /**
+      * @brief 停止监视并等待后台线程退出
+      */
+     void stop()
+     {
+          is_running = false;
+          if (thread_watch.joinable())
+               thread_watch.join();
+     }
+
+private:
+     // 被监视的文件
+     struct WatchedFile
+     {
+          std::string path;                               // add时传入的路径
+          std::string dir;                                // 所在目录
+          std::string name;                               // 文件名
+          int wd = -1;                                    // inotify监视描述符
+          std::filesystem::file_time_type time_last_write; // 轮询模式下上次的修改时间
+          bool is_changed = false;                        // 本轮是否发生变化
+     };
+
+     std::vector<WatchedFile> file_list; // 被监视的文件
+     Callback on_change;                 // 变化回调
+     double poll_interval = 0.5;         // 轮询间隔（秒）
+     std::atomic<bool> is_running{false};
+     std::thread thread_watch;
+
+     static constexpr int time_debounce_ms = 100; // 合并连续事件的等待时间
+
+private:
+     void run()
+     {
+#ifdef __linux__
+          if (run_inotify())
+               return;
+#endif
+          run_polling();
+     }
+
+     // 通知所有标记为已变化的文件
+     void flush_changed()
+     {
+          for (WatchedFile &file : file_list)
+          {
+               if (!file.is_changed)
+                    continue;
+
+               file.is_changed = false;
+               if (on_change)
+                    on_change(file.path);
+          }
+     }
+
+#ifdef __linux__
+     // inotify模式，初始化失败时返回false以退化为轮询
+     bool run_inotify()
+     {
+          int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+          if (fd < 0)
+               return false;
+
+          for (WatchedFile &file : file_list)
+          {
+               file.wd = inotify_add_watch(fd, file.dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+               if (file.wd < 0)
+               {
+                    close(fd);
+                    return false;
+               }
+          }
+
+          alignas(struct inotify_event) char buffer[4096];
+          pollfd poll_fd = {fd, POLLIN, 0};
+          while (is_running)
+          {
+               // 定期醒来检查是否需要退出
+               if (poll(&poll_fd, 1, 200) <= 0)
+                    continue;
+
+               // 等待保存操作的后续事件一起到达，再统一读取
+               std::this_thread::sleep_for(std::chrono::milliseconds(time_debounce_ms));
+
+               ssize_t size_read;
+               while ((size_read = read(fd, buffer, sizeof(buffer))) > 0)
+               {
+                    for (char *ptr = buffer; ptr < buffer + size_read;)
+                    {
+                         const inotify_event *event = (const inotify_event *)ptr;
+                         ptr += sizeof(inotify_event) + event->len;
+
+                         if (event->len == 0)
+                              continue;
+                         for (WatchedFile &file : file_list)
+                         {
+                              if (file.wd == event->wd && file.name == event->name)
+                                   file.is_changed = true;
+                         }
+                    }
+               }
+
+               flush_changed();
+          }
+
+          close(fd);
+          return true;
+     }
+#endif
+
+     // 轮询模式：定期比较文件修改时间
+     void run_polling()
+     {
+          std::error_code error;
+          for (WatchedFile &file : file_list)
+               file.time_last_write = std::filesystem::last_write_time(file.path, error);
+
+          auto time_next = std::chrono::steady_clock::now();
+          while (is_running)
+          {
+               std::this_thread::sleep_for(std::chrono::milliseconds(50));
+               if (std::chrono::steady_clock::now() < time_next)
+                    continue;
+               time_next = std::chrono::steady_clock::now() + std::chrono::milliseconds((int)(poll_interval * 1000));
+
+               for (WatchedFile &file : file_list)
+               {
+                    std::filesystem::file_time_type time_last_write = std::filesystem::last_write_time(file.path, error);
+                    if (error || time_last_write == file.time_last_write)
+                         continue;
+
+                    file.time_last_write = time_last_write;
+                    file.is_changed = true;
+               }
+
+               flush_changed();
+          }
+     }
+};
+
+#endif // !_FILE_WATCHER_H_
@@ -0,0 +1,498 @@
+#ifndef _FLOW_FIELD_H_
+#define _FLOW_FIELD_H_
+
+#include "game_map/tile.h"
+
+#include <SDL.h>
+#include <queue>
+#include <deque>
+#include <vector>
+#include <functional>
+#include <climits>
+#include <cstdint>
+
+// 流场类：所有敌人共享的寻路数据
+// 以终点为源点对可通行瓦片做广度优先搜索，得到每个瓦片到终点的步数（积分场），
+// 再为每个瓦片记录步数最小的相邻瓦片方向（流向）
+// 功能包括：
+// 1. 加载地图时完整计算一次，代价为O(瓦片数)，与敌人数量无关
+// 2. 单个瓦片的可通行状态变化时只修复受影响的区域（LPA*思路：先找出步数失去支撑的瓦片，
+//    再从区域边界重新传播），开阔地带放置防御塔通常只涉及少量瓦片
+// 3. 提供“阻挡查询”：判断阻挡某个瓦片后生成点是否仍能到达终点，只搜索受影响的区域，不修改流场；
+//    迁移防御塔时可以同时把原瓦片视为可通行
+// 4. 敌人每到达一个瓦片中心只需查询一次流向，代价为O(1)
+// 5. 不可通行的瓦片（例如刚放置防御塔的瓦片）也记录流向，站在上面的敌人可以走出来
+class FlowField
+{
+public:
+     // 无法到达终点的步数
+     static constexpr int cost_unreachable = INT_MAX;
+
+public:
+     FlowField() = default;
+     ~FlowField() = default;
+
+     // 根据地图重新计算流场
+     // @param map: 瓦片地图
+     // @param idx_home: 终点坐标
+     // @param is_walkable: 判断瓦片是否可通行的函数
+     template <typename WalkableFunc>
+     void build(const TileMap &map, const SDL_Point &idx_home, WalkableFunc is_walkable)
+     {
+          width = (int)map.get_width();
+          height = (int)map.get_height();
+
+          // 瓦片地图与流场都按行优先存放，直接线性遍历
+          const std::vector<Tile> &tile_list = map.get_tile_list();
+          walkable_list.resize(tile_list.size());
+          for (size_t i = 0; i < tile_list.size(); i++)
+               walkable_list[i] = is_walkable(tile_list[i]) ? 1 : 0;
+
+          this->idx_home = idx_home;
+          generate_cost();
+          generate_direction();
+     }
+
+     // 修改单个瓦片的可通行状态，只修复受影响的区域
+     // @param idx: 瓦片坐标
+     // @param flag: 是否可通行
+     // @return: 步数发生变化的瓦片数量
+     size_t set_walkable(const SDL_Point &idx, bool flag)
+     {
+          if (!is_inside(idx) || (walkable_list[get_idx_flat(idx)] != 0) == flag)
+               return 0;
+
+          walkable_list[get_idx_flat(idx)] = flag ? 1 : 0;
+
+          changed_list.clear();
+          if (flag)
+               repair_decrease(idx);
+          else
+               repair_increase(idx);
+
+          // 步数变化的瓦片及其邻居的流向可能改变
+          for (const SDL_Point &idx_changed : changed_list)
+          {
+               update_direction(idx_changed);
+               for (Tile::Direction direction : direction_search)
+                    update_direction(get_neighbor(idx_changed, direction));
+          }
+
+          version++;
+          return changed_list.size();
+     }
+
+     // 阻挡查询：阻挡指定瓦片后是否有出发点无法再到达终点
+     // 只在失去支撑的区域内搜索替代路线，不修改流场
+     // @param idx: 准备阻挡的瓦片坐标
+     // @param idx_source_list: 出发点坐标列表（生成点）
+     // @param idx_freed: 同时恢复可通行的瓦片坐标（迁移防御塔的原瓦片），超出地图表示没有
+     // @return: 阻挡后存在原本可以到达终点、之后无法到达的出发点时返回true
+     bool would_block(const SDL_Point &idx, const std::vector<SDL_Point> &idx_source_list, const SDL_Point &idx_freed = {-1, -1}) const
+     {
+          // 瓦片本身不可通行或无法到达终点，阻挡它不会影响任何路线
+          if (!is_inside(idx) || !walkable_list[get_idx_flat(idx)] || !is_reachable(idx))
+               return false;
+
+          collect_affected(idx);
+
+          // 之前的出发点访问过的瓦片都能走出受影响的区域，再次遇到时可以直接返回
+          uint32_t stamp_visit_begin = stamp_visit_current + 1;
+          for (const SDL_Point &idx_source : idx_source_list)
+          {
+               if (!is_inside(idx_source) || !is_affected(idx_source))
+                    continue;
+
+               if (idx_source.x == idx.x && idx_source.y == idx.y)
+                    return true;
+
+               if (!find_exit_from_affected(idx_source, stamp_visit_begin, idx_freed))
+                    return true;
+          }
+
+          return false;
+     }
+
+     // 获取瓦片到终点的步数
+     // @param idx: 瓦片坐标
+     // @return: 步数，无法到达或超出地图时返回cost_unreachable
+     int get_cost(const SDL_Point &idx) const
+     {
+          if (!is_inside(idx))
+               return cost_unreachable;
+
+          return cost_list[idx.y * width + idx.x];
+     }
+
+     // 获取瓦片的流向
+     // @param idx: 瓦片坐标
+     // @return: 朝终点前进的方向，位于终点或无路可走时返回None
+     Tile::Direction get_direction(const SDL_Point &idx) const
+     {
+          if (!is_inside(idx))
+               return Tile::Direction::None;
+
+          return (Tile::Direction)direction_list[idx.y * width + idx.x];
+     }
+
+     // 检查瓦片是否可以到达终点
+     bool is_reachable(const SDL_Point &idx) const
+     {
+          return get_cost(idx) != cost_unreachable;
+     }
+
+     // 获取流场版本号，每次重新计算后加一，敌人据此判断是否需要重新选择下一个瓦片
+     uint32_t get_version() const
+     {
+          return version;
+     }
+
+     // 获取相邻瓦片坐标
+     // @param idx: 瓦片坐标
+     // @param direction: 方向
+     static SDL_Point get_neighbor(const SDL_Point &idx, Tile::Direction direction)
+     {
+          switch (direction)
+          {
+          case Tile::Direction::Up:
+               return {idx.x, idx.y - 1};
+          case Tile::Direction::Down:
+               return {idx.x, idx.y + 1};
+          case Tile::Direction::Left:
+               return {idx.x - 1, idx.y};
+          case Tile::Direction::Right:
+               return {idx.x + 1, idx.y};
+          default:
+               return idx;
+          }
+     }
+
+private:
+     // 传播步数时的堆节点，按步数从小到大取出
+     struct OpenNode
+     {
+          int cost = 0;
+          SDL_Point idx = {0};
+
+          bool operator>(const OpenNode &other) const
+          {
+               return cost > other.cost;
+          }
+     };
+
+     typedef std::priority_queue<OpenNode, std::vector<OpenNode>, std::greater<OpenNode>> OpenHeap;
+
+private:
+     int width = 0;                       // 地图宽度（瓦片）
+     int height = 0;                      // 地图高度（瓦片）
+     SDL_Point idx_home = {0};            // 终点坐标
+     uint32_t version = 0;                // 流场版本号
+     std::vector<uint8_t> walkable_list;  // 每个瓦片是否可通行
+     std::vector<int> cost_list;          // 每个瓦片到终点的步数
+     std::vector<uint8_t> direction_list; // 每个瓦片的流向（Tile::Direction）
+
+     std::vector<SDL_Point> changed_list;          // 本次修复中步数发生变化的瓦片
+     mutable std::vector<SDL_Point> affected_list; // 失去支撑的瓦片（修复和阻挡查询共用）
+     mutable std::vector<uint32_t> stamp_affected; // 瓦片被标记为失去支撑时的标记值
+     mutable std::vector<uint32_t> stamp_visited;  // 阻挡查询中瓦片被访问时的标记值
+     mutable uint32_t stamp_current = 0;           // 当前标记值，每次查找受影响区域时加一，避免清空标记数组
+     mutable uint32_t stamp_visit_current = 0;     // 当前访问标记值，每次从出发点搜索时加一
+
+     static constexpr Tile::Direction direction_search[] = {
+         Tile::Direction::Up, Tile::Direction::Down, Tile::Direction::Left, Tile::Direction::Right};
+
+private:
+     bool is_inside(const SDL_Point &idx) const
+     {
+          return idx.x >= 0 && idx.y >= 0 && idx.x < width && idx.y < height;
+     }
+
+     int get_idx_flat(const SDL_Point &idx) const
+     {
+          return idx.y * width + idx.x;
+     }
+
+     bool is_affected(const SDL_Point &idx) const
+     {
+          return stamp_affected[get_idx_flat(idx)] == stamp_current;
+     }
+
+     // 找出阻挡指定瓦片后失去支撑的瓦片，结果写入affected_list（包含该瓦片本身）
+     // 按步数从小到大逐层检查：一个瓦片的所有“步数减一”的邻居都被阻挡或失去支撑时，它也失去支撑
+     // 只读取步数，不修改流场
+     // @param idx: 被阻挡的瓦片坐标，必须可以到达终点
+     void collect_affected(const SDL_Point &idx) const
+     {
+          if (stamp_affected.size() != cost_list.size())
+          {
+               stamp_affected.assign(cost_list.size(), 0);
+               stamp_visited.assign(cost_list.size(), 0);
+          }
+          stamp_current++;
+
+          affected_list.clear();
+          affected_list.push_back(idx);
+          stamp_affected[get_idx_flat(idx)] = stamp_current;
+
+          // 队列中瓦片的步数单调不减，检查某个瓦片时所有步数更小的瓦片都已确定
+          std::deque<SDL_Point> open_list;
+          push_successor(idx, open_list);
+
+          while (!open_list.empty())
+          {
+               SDL_Point idx_current = open_list.front();
+               open_list.pop_front();
+
+               if (is_affected(idx_current))
+                    continue;
+
+               int cost_support = cost_list[get_idx_flat(idx_current)] - 1;
+               bool is_supported = false;
+               for (Tile::Direction direction : direction_search)
+               {
+                    SDL_Point idx_neighbor = get_neighbor(idx_current, direction);
+                    if (is_inside(idx_neighbor) && walkable_list[get_idx_flat(idx_neighbor)] && !is_affected(idx_neighbor) && cost_list[get_idx_flat(idx_neighbor)] == cost_support)
+                    {
+                         is_supported = true;
+                         break;
+                    }
+               }
+
+               if (is_supported)
+                    continue;
+
+               stamp_affected[get_idx_flat(idx_current)] = stamp_current;
+               affected_list.push_back(idx_current);
+               push_successor(idx_current, open_list);
+          }
+     }
+
+     // 把步数比指定瓦片大一的可通行邻居加入队列
+     void push_successor(const SDL_Point &idx, std::deque<SDL_Point> &open_list) const
+     {
+          int cost_successor = cost_list[get_idx_flat(idx)] + 1;
+          for (Tile::Direction direction : direction_search)
+          {
+               SDL_Point idx_neighbor = get_neighbor(idx, direction);
+               if (is_inside(idx_neighbor) && walkable_list[get_idx_flat(idx_neighbor)] && cost_list[get_idx_flat(idx_neighbor)] == cost_successor)
+                    open_list.push_back(idx_neighbor);
+          }
+     }
+
+     // 阻挡查询：从失去支撑的出发点在可通行瓦片中搜索，能否走到仍可到达终点、未受影响的瓦片
+     // 搜索范围限制在受影响的区域内（被阻挡的瓦片已标记为受影响且不会被进入）
+     // 恢复可通行的瓦片当前没有有效步数，只作为通道继续搜索；经过它才能到达的不可达区域
+     // 原本就只能经过它通往终点，因此不需要进入
+     // @param idx_source: 出发点
+     // @param stamp_visit_begin: 本次查询第一次搜索的访问标记值，遇到本次查询中更早搜索访问过的瓦片时视为找到出口
+     // @param idx_freed: 视为可通行的瓦片坐标
+     bool find_exit_from_affected(const SDL_Point &idx_source, uint32_t stamp_visit_begin, const SDL_Point &idx_freed) const
+     {
+          const SDL_Point &idx_blocked = affected_list.front();
+          uint32_t stamp_visit = ++stamp_visit_current;
+
+          if (stamp_visited[get_idx_flat(idx_source)] >= stamp_visit_begin)
+               return true;
+
+          std::deque<SDL_Point> open_list;
+          open_list.push_back(idx_source);
+          stamp_visited[get_idx_flat(idx_source)] = stamp_visit;
+
+          while (!open_list.empty())
+          {
+               SDL_Point idx_current = open_list.front();
+               open_list.pop_front();
+
+               for (Tile::Direction direction : direction_search)
+               {
+                    SDL_Point idx_neighbor = get_neighbor(idx_current, direction);
+                    if (!is_inside(idx_neighbor) || (idx_neighbor.x == idx_blocked.x && idx_neighbor.y == idx_blocked.y))
+                         continue;
+
+                    int idx_flat = get_idx_flat(idx_neighbor);
+                    const bool is_freed = idx_neighbor.x == idx_freed.x && idx_neighbor.y == idx_freed.y;
+                    if ((!walkable_list[idx_flat] && !is_freed) || stamp_visited[idx_flat] == stamp_visit)
+                         continue;
+
+                    if (stamp_visited[idx_flat] >= stamp_visit_begin)
+                         return true;
+
+                    if (!is_affected(idx_neighbor) && !is_freed)
+                    {
+                         if (cost_list[idx_flat] != cost_unreachable)
+                              return true;
+                         continue;
+                    }
+
+                    stamp_visited[idx_flat] = stamp_visit;
+                    open_list.push_back(idx_neighbor);
+               }
+          }
+
+          return false;
+     }
+
+     // 瓦片被阻挡（步数只会增加）：先找出失去支撑的区域并清空步数，
+     // 再以区域边界上仍然有效的邻居为起点，在区域内按步数从小到大重新传播
+     void repair_increase(const SDL_Point &idx)
+     {
+          changed_list.push_back(idx);
+          if (!is_reachable(idx))
+               return;
+
+          collect_affected(idx);
+          for (const SDL_Point &idx_affected : affected_list)
+               cost_list[get_idx_flat(idx_affected)] = cost_unreachable;
+
+          OpenHeap open_heap;
+          for (const SDL_Point &idx_affected : affected_list)
+          {
+               if (!walkable_list[get_idx_flat(idx_affected)])
+                    continue;
+
+               int cost_best = cost_unreachable;
+               for (Tile::Direction direction : direction_search)
+               {
+                    int cost_neighbor = get_cost(get_neighbor(idx_affected, direction));
+                    if (cost_neighbor != cost_unreachable)
+                         cost_best = std::min(cost_best, cost_neighbor + 1);
+               }
+
+               if (cost_best != cost_unreachable)
+               {
+                    cost_list[get_idx_flat(idx_affected)] = cost_best;
+                    open_heap.push({cost_best, idx_affected});
+               }
+          }
+
+          propagate(open_heap);
+          changed_list.insert(changed_list.end(), affected_list.begin() + 1, affected_list.end());
+     }
+
+     // 瓦片恢复可通行（步数只会减少）：由邻居得到该瓦片的步数，再向外传播更小的步数
+     void repair_decrease(const SDL_Point &idx)
+     {
+          changed_list.push_back(idx);
+
+          int cost_best = (idx.x == idx_home.x && idx.y == idx_home.y) ? 0 : cost_unreachable;
+          for (Tile::Direction direction : direction_search)
+          {
+               int cost_neighbor = get_cost(get_neighbor(idx, direction));
+               if (cost_neighbor != cost_unreachable)
+                    cost_best = std::min(cost_best, cost_neighbor + 1);
+          }
+
+          if (cost_best >= cost_list[get_idx_flat(idx)])
+               return;
+
+          cost_list[get_idx_flat(idx)] = cost_best;
+
+          OpenHeap open_heap;
+          open_heap.push({cost_best, idx});
+          propagate(open_heap, &changed_list);
+     }
+
+     // 从堆中按步数从小到大向可通行邻居传播更小的步数
+     // @param open_heap: 已设置好步数的起点
+     // @param changed: 非空时记录步数变小的瓦片
+     void propagate(OpenHeap &open_heap, std::vector<SDL_Point> *changed = nullptr)
+     {
+          while (!open_heap.empty())
+          {
+               OpenNode node = open_heap.top();
+               open_heap.pop();
+
+               if (node.cost > cost_list[get_idx_flat(node.idx)])
+                    continue;
+
+               for (Tile::Direction direction : direction_search)
+               {
+                    SDL_Point idx_neighbor = get_neighbor(node.idx, direction);
+                    if (!is_inside(idx_neighbor))
+                         continue;
+
+                    int idx_flat = get_idx_flat(idx_neighbor);
+                    if (!walkable_list[idx_flat] || cost_list[idx_flat] <= node.cost + 1)
+                         continue;
+
+                    cost_list[idx_flat] = node.cost + 1;
+                    open_heap.push({node.cost + 1, idx_neighbor});
+                    if (changed)
+                         changed->push_back(idx_neighbor);
+               }
+          }
+     }
+
+     // 从终点出发广度优先搜索，计算每个可通行瓦片到终点的步数
+     void generate_cost()
+     {
+          cost_list.assign(width * height, cost_unreachable);
+          if (!is_inside(idx_home))
+               return;
+
+          std::deque<SDL_Point> open_list;
+          cost_list[idx_home.y * width + idx_home.x] = 0;
+          open_list.push_back(idx_home);
+
+          while (!open_list.empty())
+          {
+               SDL_Point idx = open_list.front();
+               open_list.pop_front();
+               int cost_next = cost_list[idx.y * width + idx.x] + 1;
+
+               for (Tile::Direction direction : direction_search)
+               {
+                    SDL_Point idx_neighbor = get_neighbor(idx, direction);
+                    if (!is_inside(idx_neighbor))
+                         continue;
+
+                    int idx_flat = idx_neighbor.y * width + idx_neighbor.x;
+                    if (!walkable_list[idx_flat] || cost_list[idx_flat] <= cost_next)
+                         continue;
+
+                    cost_list[idx_flat] = cost_next;
+                    open_list.push_back(idx_neighbor);
+               }
+          }
+     }
+
+     // 计算所有瓦片的流向
+     void generate_direction()
+     {
+          direction_list.assign(width * height, (uint8_t)Tile::Direction::None);
+
+          for (int y = 0; y < height; y++)
+               for (int x = 0; x < width; x++)
+                    update_direction({x, y});
+
+          version++;
+     }
+
+     // 为瓦片选择步数最小的相邻瓦片作为流向，步数相同时按上、下、左、右的顺序选择
+     // @param idx: 瓦片坐标
+     void update_direction(const SDL_Point &idx)
+     {
+          if (!is_inside(idx))
+               return;
+
+          int idx_flat = get_idx_flat(idx);
+          int cost_best = cost_list[idx_flat];
+
+          // 不可通行的瓦片向任意可到达的邻居移动
+          if (!walkable_list[idx_flat])
+               cost_best = cost_unreachable;
+
+          direction_list[idx_flat] = (uint8_t)Tile::Direction::None;
+          for (Tile::Direction direction : direction_search)
+          {
+               int cost_neighbor = get_cost(get_neighbor(idx, direction));
+               if (cost_neighbor < cost_best)
+               {
+                    cost_best = cost_neighbor;
+                    direction_list[idx_flat] = (uint8_t)direction;
+               }
+          }
+     }
+};
+
+#endif // !_FLOW_FIELD_H_
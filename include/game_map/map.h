@@ -3,94 +3,89 @@
 
 #include "game_map/tile.h"
 #include "game_map/route.h"
+#include "game_map/flow_field.h"
+#include "game_map/map_parser.h"
+#include "game_map/map_binary.h"
 
 #include <SDL.h>
 #include <string>
-#include <fstream>
-#include <sstream>
 #include <unordered_map>
 #include <iostream>
 
 // 地图类：管理游戏地图的加载和访问
+// 默认模式下敌人沿瓦片上的方向标记生成的固定路径移动；
+// 自由寻路模式下敌人按流场走向终点，放置防御塔会阻挡瓦片并更新流场，可以用防御塔搭建迷宫
 class Map
 {
 public:
      // 生成点路径池类型定义：键为生成点ID，值为对应的路径
-     typedef std::unordered_map<int, Route> SpawnerRoutePool;
+     typedef MapBinary::SpawnerRoutePool SpawnerRoutePool;
 
 public:
      Map() = default;
      ~Map() = default;
 
-     // 从文件加载地图
+     // 从文件加载地图，根据文件开头的魔数自动识别CSV或二进制格式
+     // 二进制地图中已经包含终点和追踪好的生成点路径，加载时不再追踪路径
      // @param path: 地图文件路径
      // @return: 加载成功返回true，否则返回false
      bool load(const std::string &path)
      {
-          std::ifstream file(path);
-          if (!file.good())
+          MappedFile file;
+          if (!file.open(path))
           {
                std::cerr << "Failed to open map file: " << path << std::endl;
                return false;
           }
 
-          TileMap tile_map_temp;
-
-          int idx_x = -1, idx_y = -1;
-
-          // 逐行读取地图文件
-          std::string str_line;
-          while (std::getline(file, str_line))
+          // 在映射到内存的文件上直接解析，失败时保留原有地图数据
+          MapParseError error;
+          bool is_binary = MapBinary::is_binary(file.begin(), file.end());
+          bool is_loaded = is_binary ? MapBinary::read(file.begin(), file.end(), tile_map, idx_home, spwaner_route_pool, error)
+                                     : MapParser::parse_csv(file.begin(), file.end(), tile_map, error);
+          if (!is_loaded)
           {
-               str_line = trim_str(str_line);
-               if (str_line.empty())
-                    continue;
-
-               idx_x = -1, idx_y++;
-               tile_map_temp.emplace_back();
-
-               // 解析每行的瓦片数据
-               std::string str_tile;
-               std::stringstream str_stream(str_line);
-               while (std::getline(str_stream, str_tile, ','))
-               {
-                    idx_x++;
-                    tile_map_temp[idx_y].emplace_back();
-                    Tile &tile = tile_map_temp[idx_y].back();
-                    load_tile_from_string(tile, str_tile);
-                    std::cout << "Loaded tile at (" << idx_x << "," << idx_y << "): " << str_tile << std::endl;
-               }
+               std::cerr << "Failed to load map file " << error.to_string(path) << std::endl;
+               return false;
           }
 
-          file.close();
-
-          if (tile_map_temp.empty() || tile_map_temp[0].empty())
+          // 生成地图缓存（终点和路径），二进制地图只需收集生成点坐标
+          if (is_binary)
           {
-               std::cerr << "Map file is empty or invalid." << std::endl;
-               return false;
+               idx_spawner_list.clear();
+               for (const auto &pair : spwaner_route_pool)
+               {
+                    if (!pair.second.get_idx_list().empty())
+                         idx_spawner_list.push_back(pair.second.get_idx_list().front());
+               }
           }
+          else
+               generate_map_cache();
 
-          tile_map = tile_map_temp;
-
-          // 生成地图缓存（终点和路径）
-          generate_map_cache();
+          if (is_free_pathing_flag)
+               flow_field.build(tile_map, idx_home, is_walkable);
 
           return true;
      }
 
+     // 把当前地图（瓦片、终点和生成点路径）写出为二进制格式
+     // @param path: 输出文件路径
+     // @return: 写出成功返回true，否则返回false
+     bool save_binary(const std::string &path) const
+     {
+          return MapBinary::write(path, tile_map, idx_home, spwaner_route_pool);
+     }
+
      // 获取地图宽度
      size_t get_width() const
      {
-          if (tile_map.empty())
-               return 0;
-
-          return tile_map[0].size();
+          return tile_map.get_width();
      }
 
      // 获取地图高度
      size_t get_height() const
      {
-          return tile_map.size();
+          return tile_map.get_height();
      }
 
      // 获取瓦片地图数据
@@ -111,74 +106,100 @@ public:
           return spwaner_route_pool;
      }
 
+     // 设置是否启用自由寻路，需在加载地图之前调用
+     // @param flag: 是否启用
+     void set_free_pathing(bool flag)
+     {
+          is_free_pathing_flag = flag;
+     }
+
+     // 检查是否启用自由寻路
+     bool is_free_pathing() const
+     {
+          return is_free_pathing_flag;
+     }
+
+     // 获取流场（仅在自由寻路模式下有效）
+     const FlowField &get_flow_field() const
+     {
+          return flow_field;
+     }
+
+     // 检查瓦片在自由寻路模式下是否可通行：没有装饰物且没有防御塔，终点和生成点始终可通行
+     // @param tile: 瓦片
+     static bool is_walkable(const Tile &tile)
+     {
+          if (tile.special_flag >= 0)
+               return true;
+
+          return tile.decoration < 0 && !tile.has_tower();
+     }
+
      // 在指定位置放置防御塔
      // @param idx_tile: 防御塔放置的瓦片坐标
      void place_tower(const SDL_Point &idx_tile)
      {
-          tile_map[idx_tile.y][idx_tile.x].has_tower = true;
-     }
+          tile_map.at(idx_tile).set_has_tower(true);
+          dirty_tile_list.push_back(idx_tile);
 
-private:
-     TileMap tile_map;                    // 瓦片地图数据
-     SDL_Point idx_home = {0};            // 终点坐标
-     SpawnerRoutePool spwaner_route_pool; // 生成点路径池
+          // 防御塔阻挡了瓦片，只修复流场中受影响的区域
+          if (is_free_pathing_flag)
+               flow_field.set_walkable(idx_tile, is_walkable(tile_map.at(idx_tile)));
+     }
 
-private:
-     // 去除字符串首尾的空白字符
-     // @param str: 输入字符串
-     // @return: 处理后的字符串
-     std::string trim_str(const std::string &str)
+     // 移除指定位置的防御塔（出售或迁移）
+     // @param idx_tile: 防御塔所在的瓦片坐标
+     void remove_tower(const SDL_Point &idx_tile)
      {
-          size_t begin_idx = str.find_first_not_of(" \t");
-          if (begin_idx == std::string::npos)
-               return "";
-          size_t end_idx = str.find_last_not_of(" \t");
-          size_t idx_range = end_idx - begin_idx + 1;
+          tile_map.at(idx_tile).set_has_tower(false);
+          dirty_tile_list.push_back(idx_tile);
 
-          return str.substr(begin_idx, idx_range);
+          // 瓦片重新可通行，只修复流场中受影响的区域
+          if (is_free_pathing_flag)
+               flow_field.set_walkable(idx_tile, is_walkable(tile_map.at(idx_tile)));
      }
 
-     // 从字符串加载瓦片数据
-     // @param tile: 目标瓦片
-     // @param str: 瓦片数据字符串，格式：地形\装饰\方向\特殊标记
-     void load_tile_from_string(Tile &tile, const std::string &str)
+     // 检查在指定位置放置防御塔是否会使某个生成点无法到达终点
+     // @param idx_tile: 准备放置防御塔的瓦片坐标
+     // @param idx_freed: 同时移走防御塔的瓦片坐标（迁移时的原瓦片），超出地图表示没有；只用于查询，不修改地图
+     // @return: 会阻断路线时返回true，非自由寻路模式下总是返回false
+     bool would_block_path(const SDL_Point &idx_tile, const SDL_Point &idx_freed = {-1, -1}) const
      {
-          std::string str_tidy = trim_str(str);
-
-          std::string str_value;
-          std::vector<int> values;
-          std::stringstream str_stream(str_tidy);
+          if (!is_free_pathing_flag)
+               return false;
 
-          // 解析瓦片属性
-          while (std::getline(str_stream, str_value, '\\'))
-          {
-               int value;
-               try
-               {
-                    value = std::stoi(str_value);
-               }
-               catch (const std::invalid_argument &)
-               {
-                    value = -1;
-               }
-               values.push_back(value);
-          }
+          return flow_field.would_block(idx_tile, idx_spawner_list, idx_freed);
+     }
 
-          // 设置瓦片属性
-          tile.terrian = (values.size() < 1 || values[0] < 0) ? 0 : values[0];
-          tile.decoration = (values.size() < 2) ? -1 : values[1];
-          tile.direction = (Tile::Direction)((values.size() < 3 || values[2] < 0) ? 0 : values[2]);
-          tile.special_flag = (values.size() <= 3) ? -1 : values[3];
+     // 取出自上次调用以来发生变化的瓦片坐标，供渲染器重新烘焙对应区块
+     // @param dst: 接收变化瓦片坐标的列表，原有内容会被替换
+     void take_dirty_tile_list(std::vector<SDL_Point> &dst)
+     {
+          dst.clear();
+          dst.swap(dirty_tile_list);
      }
 
-     // 生成地图缓存：记录终点位置和生成点路径
+private:
+     TileMap tile_map;                        // 瓦片地图数据
+     SDL_Point idx_home = {0};                // 终点坐标
+     SpawnerRoutePool spwaner_route_pool;     // 生成点路径池
+     std::vector<SDL_Point> dirty_tile_list;  // 发生变化、等待重新烘焙的瓦片
+     bool is_free_pathing_flag = false;       // 是否启用自由寻路
+     FlowField flow_field;                    // 自由寻路模式下所有敌人共享的流场
+     std::vector<SDL_Point> idx_spawner_list; // 所有生成点的坐标，用于阻挡查询
+
+private:
+     // 生成地图缓存：记录终点位置，沿方向标记追踪生成点路径
      void generate_map_cache()
      {
+          spwaner_route_pool.clear();
+          idx_spawner_list.clear();
+
           for (int y = 0; y < get_height(); y++)
           {
                for (int x = 0; x < get_width(); x++)
                {
-                    const Tile &tile = tile_map[y][x];
+                    const Tile &tile = tile_map.at(x, y);
                     if (tile.special_flag < 0)
                          continue;
 
@@ -192,6 +213,7 @@ private:
                     else
                     {
                          spwaner_route_pool[tile.special_flag] = Route(tile_map, {x, y});
+                         idx_spawner_list.push_back({x, y});
                     }
                }
           }
@@ -0,0 +1,210 @@
+#ifndef _MAP_BINARY_H_
+#define _MAP_BINARY_H_
+
+#include "game_map/tile.h"
+#include "game_map/route.h"
+#include "game_map/map_parser.h"
+
+#include <SDL.h>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include <unordered_map>
+
+// 二进制地图格式（小端序）：
+//   文件头      MapBinary::Header，32字节，包含魔数、版本号、尺寸、终点坐标和路径数量
+//   瓦片数组    width * height 个 Tile，按行优先排列，与内存中的布局完全一致
+//   路径表      num_route 个 RouteEntry（生成点ID、路径点数量）
+//   路径点数组  所有路径的路径点依次排列，每个点为两个int32（x, y）
+// 加载时只需一次映射和几次内存拷贝，不需要解析文本，也不需要沿方向标记重新追踪路径
+class MapBinary
+{
+public:
+     // 生成点路径池类型定义，与Map::SpawnerRoutePool一致
+     typedef std::unordered_map<int, Route> SpawnerRoutePool;
+
+     // 当前格式版本，布局变化时递增
+     static constexpr uint32_t version = 1;
+
+public:
+     // 检查数据是否为二进制地图（以魔数开头）
+     // @param begin: 数据起始地址
+     // @param end: 数据结束地址
+     static bool is_binary(const char *begin, const char *end)
+     {
+          return (size_t)(end - begin) >= sizeof(magic) && std::memcmp(begin, magic, sizeof(magic)) == 0;
+     }
+
+     // 读取二进制地图
+     // @param begin: 数据起始地址
+     // @param end: 数据结束地址
+     // @param dst_tile_map: 瓦片地图，失败时保持不变
+     // @param dst_idx_home: 终点坐标，失败时保持不变
+     // @param dst_route_pool: 生成点路径池，失败时保持不变
+     // @param error: 失败时填写原因
+     // @return: 读取成功返回true，否则返回false
+     static bool read(const char *begin, const char *end, TileMap &dst_tile_map, SDL_Point &dst_idx_home, SpawnerRoutePool &dst_route_pool, MapParseError &error)
+     {
+          error = MapParseError();
+          size_t size = (size_t)(end - begin);
+
+          Header header;
+          if (size < sizeof(Header) || !is_binary(begin, end))
+          {
+               error.message = "not a binary map file";
+               return false;
+          }
+          std::memcpy(&header, begin, sizeof(Header));
+
+          if (header.version != version)
+          {
+               error.message = "unsupported binary map version " + std::to_string(header.version) + ", expected " + std::to_string(version);
+               return false;
+          }
+
+          size_t num_tile = (size_t)header.width * header.height;
+          size_t offset_route = sizeof(Header) + num_tile * sizeof(Tile);
+          size_t offset_point = offset_route + (size_t)header.num_route * sizeof(RouteEntry);
+          if (num_tile == 0 || size < offset_point)
+          {
+               error.message = "binary map file is truncated";
+               return false;
+          }
+
+          TileMap tile_map;
+          std::vector<Tile> tile_list(num_tile);
+          std::memcpy(tile_list.data(), begin + sizeof(Header), num_tile * sizeof(Tile));
+          tile_map.assign(header.width, header.height, std::move(tile_list));
+
+          SDL_Point idx_home = {header.home_x, header.home_y};
+          if (!tile_map.is_inside(idx_home))
+          {
+               error.message = "home tile is outside the map";
+               return false;
+          }
+
+          SpawnerRoutePool route_pool;
+          const char *ptr_point = begin + offset_point;
+          for (uint32_t i = 0; i < header.num_route; i++)
+          {
+               RouteEntry entry;
+               std::memcpy(&entry, begin + offset_route + i * sizeof(RouteEntry), sizeof(RouteEntry));
+
+               if ((size_t)(end - ptr_point) < (size_t)entry.num_point * sizeof(Point))
+               {
+                    error.message = "binary map file is truncated";
+                    return false;
+               }
+
+               Route::IdxList idx_list(entry.num_point);
+               for (SDL_Point &idx : idx_list)
+               {
+                    Point point;
+                    std::memcpy(&point, ptr_point, sizeof(Point));
+                    ptr_point += sizeof(Point);
+
+                    idx = {point.x, point.y};
+                    if (!tile_map.is_inside(idx))
+                    {
+                         error.message = "route of spawner " + std::to_string(entry.id_spawner) + " leaves the map";
+                         return false;
+                    }
+               }
+
+               route_pool[entry.id_spawner] = Route(std::move(idx_list));
+          }
+
+          dst_tile_map = std::move(tile_map);
+          dst_idx_home = idx_home;
+          dst_route_pool.swap(route_pool);
+
+          return true;
+     }
+
+     // 写出二进制地图
+     // @param path: 输出文件路径
+     // @param tile_map: 瓦片地图
+     // @param idx_home: 终点坐标
+     // @param route_pool: 生成点路径池
+     // @return: 写出成功返回true，否则返回false
+     static bool write(const std::string &path, const TileMap &tile_map, const SDL_Point &idx_home, const SpawnerRoutePool &route_pool)
+     {
+          FILE *file = std::fopen(path.c_str(), "wb");
+          if (!file)
+               return false;
+
+          Header header;
+          header.width = (uint32_t)tile_map.get_width();
+          header.height = (uint32_t)tile_map.get_height();
+          header.home_x = idx_home.x;
+          header.home_y = idx_home.y;
+          header.num_route = (uint32_t)route_pool.size();
+
+          // 运行时状态（是否有防御塔）不写入文件
+          std::vector<Tile> tile_list = tile_map.get_tile_list();
+          for (Tile &tile : tile_list)
+               tile.set_has_tower(false);
+
+          // 按生成点ID排序写出，保证同一张地图每次转换得到相同的文件
+          std::vector<int> id_spawner_list;
+          for (const auto &pair : route_pool)
+               id_spawner_list.push_back(pair.first);
+          std::sort(id_spawner_list.begin(), id_spawner_list.end());
+
+          std::vector<RouteEntry> entry_list;
+          std::vector<Point> point_list;
+          for (int id_spawner : id_spawner_list)
+          {
+               const Route::IdxList &idx_list = route_pool.at(id_spawner).get_idx_list();
+               entry_list.push_back({id_spawner, (uint32_t)idx_list.size()});
+               for (const SDL_Point &idx : idx_list)
+                    point_list.push_back({idx.x, idx.y});
+          }
+
+          bool is_ok = std::fwrite(&header, sizeof(Header), 1, file) == 1;
+          is_ok = is_ok && std::fwrite(tile_list.data(), sizeof(Tile), tile_list.size(), file) == tile_list.size();
+          is_ok = is_ok && std::fwrite(entry_list.data(), sizeof(RouteEntry), entry_list.size(), file) == entry_list.size();
+          is_ok = is_ok && std::fwrite(point_list.data(), sizeof(Point), point_list.size(), file) == point_list.size();
+
+          return std::fclose(file) == 0 && is_ok;
+     }
+
+private:
+     static constexpr char magic[4] = {'T', 'D', 'M', 'P'};
+
+     // 文件头
+     struct Header
+     {
+          char magic[4] = {'T', 'D', 'M', 'P'}; // 魔数
+          uint32_t version = MapBinary::version; // 格式版本
+          uint32_t width = 0;                    // 地图宽度（瓦片）
+          uint32_t height = 0;                   // 地图高度（瓦片）
+          int32_t home_x = 0;                    // 终点横坐标
+          int32_t home_y = 0;                    // 终点纵坐标
+          uint32_t num_route = 0;                // 生成点路径数量
+          uint32_t reserved = 0;                 // 保留，填0
+     };
+
+     // 路径表项
+     struct RouteEntry
+     {
+          int32_t id_spawner; // 生成点ID
+          uint32_t num_point; // 路径点数量
+     };
+
+     // 路径点
+     struct Point
+     {
+          int32_t x;
+          int32_t y;
+     };
+
+     static_assert(sizeof(Header) == 32, "binary map header must be 32 bytes");
+     static_assert(sizeof(Tile) == 6 && std::is_trivially_copyable<Tile>::value, "binary map stores tiles verbatim");
+};
+
+#endif // !_MAP_BINARY_H_
@@ -0,0 +1,242 @@
+#ifndef _MAP_PARSER_H_
+#define _MAP_PARSER_H_
+
+#include "mapped_file.h"
+#include "game_map/tile.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <charconv>
+#include <system_error>
+
+// 地图解析错误：记录出错位置（行号和列号均从1开始）和原因
+struct MapParseError
+{
+     size_t line = 0;     // 出错的行号
+     size_t column = 0;   // 出错的列号（字节）
+     std::string message; // 错误原因
+
+     // 格式化为 "路径:行:列: 原因"
+     // @param path: 地图文件路径
+     std::string to_string(const std::string &path) const
+     {
+          if (line == 0)
+               return path + ": " + message;
+
+          return path + ":" + std::to_string(line) + ":" + std::to_string(column) + ": " + message;
+     }
+};
+
+// CSV地图解析器：在映射到内存的文件上单遍扫描，用from_chars直接解析数字
+// 不创建逐行、逐字段的临时字符串，除了存放瓦片的数组外不做任何分配
+// 格式：每行一排瓦片，瓦片之间用逗号分隔，瓦片内部格式为 地形\装饰\方向\特殊标记，
+// 字段可以省略或留空（使用默认值），首尾空白和空行会被忽略，行尾允许多余的逗号
+class MapParser
+{
+public:
+     // 从文件加载CSV地图
+     // @param path: 地图文件路径
+     // @param dst: 解析结果，失败时保持不变
+     // @param error: 失败时填写出错位置和原因
+     // @return: 加载成功返回true，否则返回false
+     static bool load_csv(const std::string &path, TileMap &dst, MapParseError &error)
+     {
+          MappedFile file;
+          if (!file.open(path))
+          {
+               error = MapParseError();
+               error.message = "failed to open map file";
+               return false;
+          }
+
+          return parse_csv(file.begin(), file.end(), dst, error);
+     }
+
+     // 解析内存中的CSV地图数据
+     // @param begin: 数据起始地址
+     // @param end: 数据结束地址
+     // @param dst: 解析结果，失败时保持不变
+     // @param error: 失败时填写出错位置和原因
+     // @return: 解析成功返回true，否则返回false
+     static bool parse_csv(const char *begin, const char *end, TileMap &dst, MapParseError &error)
+     {
+          Cursor cursor = {begin, end, begin, 1};
+
+          std::vector<Tile> tile_list;
+          size_t width = 0, height = 0;
+
+          while (cursor.ptr < end)
+          {
+               skip_blank(cursor);
+
+               // 空行
+               if (cursor.ptr == end || is_line_end(*cursor.ptr))
+               {
+                    next_line(cursor);
+                    continue;
+               }
+
+               size_t num_tile_line = 0;
+               while (true)
+               {
+                    Tile tile;
+                    if (!parse_tile(cursor, tile, error))
+                         return false;
+                    tile_list.push_back(tile);
+                    num_tile_line++;
+
+                    if (cursor.ptr == end || is_line_end(*cursor.ptr))
+                         break;
+
+                    // parse_tile保证停在逗号或行尾
+                    cursor.ptr++;
+                    skip_blank(cursor);
+                    if (cursor.ptr == end || is_line_end(*cursor.ptr))
+                         break;
+               }
+
+               if (height == 0)
+               {
+                    // 根据第一行的字节数估算总行数，通常一次就分配到位
+                    width = num_tile_line;
+                    size_t size_line = (size_t)(cursor.ptr - cursor.line_begin) + 1;
+                    tile_list.reserve(width * ((size_t)(end - begin) / size_line + 1));
+               }
+               else if (num_tile_line != width)
+               {
+                    error.line = cursor.line;
+                    error.column = 1;
+                    error.message = "row has " + std::to_string(num_tile_line) + " tiles, expected " + std::to_string(width);
+                    return false;
+               }
+               height++;
+
+               next_line(cursor);
+          }
+
+          if (width == 0 || height == 0)
+          {
+               error = MapParseError();
+               error.message = "map file is empty";
+               return false;
+          }
+
+          dst.assign(width, height, std::move(tile_list));
+          return true;
+     }
+
+private:
+     // 扫描位置
+     struct Cursor
+     {
+          const char *ptr;        // 当前读取位置
+          const char *end;        // 数据结束地址
+          const char *line_begin; // 当前行的起始地址，用于计算列号
+          size_t line;            // 当前行号
+     };
+
+     static bool is_blank(char c)
+     {
+          return c == ' ' || c == '\t';
+     }
+
+     static bool is_line_end(char c)
+     {
+          return c == '\n' || c == '\r';
+     }
+
+     static void skip_blank(Cursor &cursor)
+     {
+          while (cursor.ptr < cursor.end && is_blank(*cursor.ptr))
+               cursor.ptr++;
+     }
+
+     // 跳过行尾的换行符（兼容\r\n），进入下一行
+     static void next_line(Cursor &cursor)
+     {
+          if (cursor.ptr < cursor.end && *cursor.ptr == '\r')
+               cursor.ptr++;
+          if (cursor.ptr < cursor.end && *cursor.ptr == '\n')
+               cursor.ptr++;
+
+          cursor.line++;
+          cursor.line_begin = cursor.ptr;
+     }
+
+     static void set_error(const Cursor &cursor, const char *ptr, const std::string &message, MapParseError &error)
+     {
+          error.line = cursor.line;
+          error.column = (size_t)(ptr - cursor.line_begin) + 1;
+          error.message = message;
+     }
+
+     // 解析一个瓦片，结束时停在分隔瓦片的逗号、行尾或数据末尾
+     // @param cursor: 扫描位置
+     // @param tile: 解析结果
+     // @param error: 失败时填写出错位置和原因
+     static bool parse_tile(Cursor &cursor, Tile &tile, MapParseError &error)
+     {
+          // 依次为 地形、装饰、方向、特殊标记，省略的字段为-1
+          static constexpr int num_field = 4;
+          static const char *const field_name[num_field] = {"terrain", "decoration", "direction", "special flag"};
+          static constexpr int value_min[num_field] = {-1, -1, -1, -1};
+          static constexpr int value_max[num_field] = {UINT16_MAX, INT16_MAX, (int)Tile::Direction::Right, INT8_MAX};
+
+          int values[num_field] = {-1, -1, -1, -1};
+          int idx_field = 0;
+
+          while (true)
+          {
+               skip_blank(cursor);
+
+               const char *field_begin = cursor.ptr;
+               if (cursor.ptr < cursor.end && *cursor.ptr != '\\' && *cursor.ptr != ',' && !is_line_end(*cursor.ptr))
+               {
+                    if (idx_field >= num_field)
+                    {
+                         set_error(cursor, field_begin, "too many fields in tile, expected at most 4", error);
+                         return false;
+                    }
+
+                    int value = 0;
+                    std::from_chars_result result = std::from_chars(cursor.ptr, cursor.end, value);
+                    if (result.ec == std::errc::invalid_argument)
+                    {
+                         set_error(cursor, field_begin, std::string("expected an integer for ") + field_name[idx_field], error);
+                         return false;
+                    }
+                    if (result.ec == std::errc::result_out_of_range || value < value_min[idx_field] || value > value_max[idx_field])
+                    {
+                         set_error(cursor, field_begin, std::string(field_name[idx_field]) + " out of range [" + std::to_string(value_min[idx_field]) + ", " + std::to_string(value_max[idx_field]) + "]", error);
+                         return false;
+                    }
+
+                    values[idx_field] = value;
+                    cursor.ptr = result.ptr;
+                    skip_blank(cursor);
+               }
+
+               if (cursor.ptr == cursor.end || *cursor.ptr == ',' || is_line_end(*cursor.ptr))
+                    break;
+
+               if (*cursor.ptr != '\\')
+               {
+                    set_error(cursor, cursor.ptr, std::string("unexpected character '") + *cursor.ptr + "' after " + field_name[idx_field < num_field ? idx_field : num_field - 1], error);
+                    return false;
+               }
+
+               cursor.ptr++;
+               idx_field++;
+          }
+
+          tile.terrian = (uint16_t)(values[0] < 0 ? 0 : values[0]);
+          tile.decoration = (int16_t)values[1];
+          tile.set_direction((Tile::Direction)(values[2] < 0 ? 0 : values[2]));
+          tile.special_flag = (int8_t)values[3];
+
+          return true;
+     }
+};
+
+#endif // !_MAP_PARSER_H_
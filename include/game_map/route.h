@@ -2,16 +2,22 @@
 #define _ROUTE_H_
 
 #include "game_map/tile.h"
+#include "game_map/vector2.h"
 
 #include <SDL.h>
 #include <vector>
+#include <utility>
 
 // 路径类：表示从生成点到终点的路径
+// 构造时预计算每个路径点的像素位置（相对地图左上角的瓦片中心）和累计弧长，
+// 敌人只需记录沿路径走过的距离，即可O(1)查询位置、方向和进度
 class Route
 {
 public:
      // 路径点列表类型定义
      typedef std::vector<SDL_Point> IdxList;
+     // 路径点像素位置列表类型定义
+     typedef std::vector<Vector2> PositionList;
 
 public:
      Route() = default;
@@ -21,15 +27,13 @@ public:
      // @param idx_origin: 路径的起始点坐标
      Route(const TileMap &map, const SDL_Point &idx_origin)
      {
-          size_t width_map = map[0].size();
-          size_t height_map = map.size();
           SDL_Point idx_next = idx_origin;
 
           // 沿着地图上的方向标记生成路径
           while (true)
           {
                // 检查是否超出地图边界
-               if (idx_next.x >= width_map || idx_next.y >= height_map)
+               if (!map.is_inside(idx_next))
                     break;
 
                // 检查是否出现重复路径点
@@ -39,14 +43,14 @@ public:
                     idx_list.push_back(idx_next);
 
                bool is_next_dir_exist = true;
-               const Tile &tile = map[idx_next.y][idx_next.x];
+               const Tile &tile = map.at(idx_next);
 
                // 到达终点（特殊标记为0的点）
                if (tile.special_flag == 0)
                     break;
 
                // 根据瓦片的方向确定下一个路径点
-               switch (tile.direction)
+               switch (tile.get_direction())
                {
                case Tile::Direction::Up:
                     idx_next.y--;
@@ -68,6 +72,15 @@ public:
                if (!is_next_dir_exist)
                     break;
           }
+
+          generate_geometry();
+     }
+
+     // 构造函数：直接使用已经追踪好的路径点（例如从二进制地图文件中读取），不再沿方向标记追踪
+     // @param idx_list: 从生成点到终点的路径点
+     explicit Route(IdxList idx_list) : idx_list(std::move(idx_list))
+     {
+          generate_geometry();
      }
 
      ~Route() = default;
@@ -78,10 +91,92 @@ public:
           return idx_list;
      }
 
+     // 获取路径点像素位置列表（相对地图左上角）
+     const PositionList &get_position_list() const
+     {
+          return position_list;
+     }
+
+     // 获取路径总长度（像素）
+     double get_length() const
+     {
+          return length_list.empty() ? 0 : length_list.back();
+     }
+
+     // 查询沿路径走过指定距离时所在的线段
+     // 敌人只会向前移动，传入上次的线段索引作为起点，均摊O(1)
+     // @param distance: 沿路径走过的距离（像素）
+     // @param idx_segment: 输入上次所在的线段索引，输出当前所在的线段索引
+     void locate_segment(double distance, size_t &idx_segment) const
+     {
+          if (position_list.size() < 2)
+          {
+               idx_segment = 0;
+               return;
+          }
+
+          size_t idx_segment_last = position_list.size() - 2;
+          while (idx_segment < idx_segment_last && length_list[idx_segment + 1] <= distance)
+               idx_segment++;
+     }
+
+     // 获取沿路径走过指定距离时的位置（相对地图左上角）
+     // @param distance: 沿路径走过的距离（像素），超出路径长度时停在终点
+     // @param idx_segment: 当前所在的线段索引，由locate_segment得到
+     Vector2 get_position(double distance, size_t idx_segment) const
+     {
+          if (position_list.empty())
+               return Vector2();
+          if (position_list.size() == 1 || distance >= get_length())
+               return position_list.back();
+
+          double length_segment = length_list[idx_segment + 1] - length_list[idx_segment];
+          double t = length_segment > 0 ? (distance - length_list[idx_segment]) / length_segment : 0;
+          return position_list[idx_segment] + (position_list[idx_segment + 1] - position_list[idx_segment]) * t;
+     }
+
+     // 获取指定线段的单位方向
+     // @param idx_segment: 线段索引
+     const Vector2 &get_direction(size_t idx_segment) const
+     {
+          static const Vector2 direction_none;
+          if (idx_segment >= direction_list.size())
+               return direction_none;
+
+          return direction_list[idx_segment];
+     }
+
 private:
-     IdxList idx_list; // 存储路径上的所有点
+     IdxList idx_list;                    // 存储路径上的所有点
+     PositionList position_list;          // 路径点的像素位置（瓦片中心，相对地图左上角）
+     std::vector<double> length_list;     // 从起点到每个路径点的累计弧长
+     std::vector<Vector2> direction_list; // 每条线段的单位方向
 
 private:
+     // 根据路径点生成像素位置、累计弧长和线段方向表
+     void generate_geometry()
+     {
+          position_list.clear();
+          length_list.clear();
+          direction_list.clear();
+
+          for (const SDL_Point &idx : idx_list)
+          {
+               Vector2 position(idx.x * SIZE_TILE + SIZE_TILE / 2, idx.y * SIZE_TILE + SIZE_TILE / 2);
+
+               if (position_list.empty())
+                    length_list.push_back(0);
+               else
+               {
+                    Vector2 offset = position - position_list.back();
+                    length_list.push_back(length_list.back() + offset.length());
+                    direction_list.push_back(offset.normalize());
+               }
+
+               position_list.push_back(position);
+          }
+     }
+
      // 检查路径点是否重复
      // @param target_idx: 要检查的路径点
      // @return: 如果路径点已存在返回true，否则返回false
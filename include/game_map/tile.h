@@ -2,6 +2,8 @@
 #define _TILE_H_
 
 #include <vector>
+#include <cstdint>
+#include <utility>
 #include <SDL.h>
 
 // Forward declarations
@@ -9,9 +11,12 @@ class ConfigManager;
 
 #define SIZE_TILE 48
 
+// 瓦片：紧凑存储，共6字节
+// 地形和装饰为瓦片集索引，特殊标记为-1（无）、0（基地）或生成点编号（1-127），
+// 方向和是否有防御塔打包在同一个字节中，通过访问函数读写
 struct Tile
 {
-	enum class Direction
+	enum class Direction : uint8_t
 	{
 		None = 0,
 		Up,
@@ -20,11 +25,30 @@ struct Tile
 		Right
 	};
 
-	int terrian = 0;
-	int decoration = -1;
-	int special_flag = -1;
-	bool has_tower = false; // during running the game, check if the tile already has a tower
-	Direction direction = Direction::None;
+	uint16_t terrian = 0;     // 地形在瓦片集中的索引
+	int16_t decoration = -1;  // 装饰在瓦片集中的索引，-1表示没有装饰
+	int8_t special_flag = -1; // 特殊标记
+
+	Direction get_direction() const
+	{
+		return (Direction)(flags & mask_direction);
+	}
+
+	void set_direction(Direction direction)
+	{
+		flags = (uint8_t)((flags & ~mask_direction) | ((uint8_t)direction & mask_direction));
+	}
+
+	// during running the game, check if the tile already has a tower
+	bool has_tower() const
+	{
+		return (flags & mask_has_tower) != 0;
+	}
+
+	void set_has_tower(bool flag)
+	{
+		flags = flag ? (uint8_t)(flags | mask_has_tower) : (uint8_t)(flags & ~mask_has_tower);
+	}
 
 	// 根据瓦片索引获取瓦片中心位置
 	static SDL_Point get_pos_by_idx(const SDL_Point &idx, const SDL_Rect &rect_tile_map)
@@ -34,8 +58,101 @@ struct Tile
 		pos.y = rect_tile_map.y + idx.y * SIZE_TILE + SIZE_TILE / 2;
 		return pos;
 	}
+
+private:
+	static constexpr uint8_t mask_direction = 0x07; // 低3位：方向
+	static constexpr uint8_t mask_has_tower = 0x08; // 第4位：是否有防御塔
+
+	uint8_t flags = 0; // 打包的方向和防御塔标记
 };
 
-typedef std::vector<std::vector<Tile>> TileMap;
+// 瓦片地图：按行优先存放在一块连续内存中
+// 遍历整张地图时按内存顺序线性访问，查询单个瓦片不需要经过行指针
+class TileMap
+{
+public:
+	TileMap() = default;
+
+	TileMap(size_t width, size_t height)
+	{
+		resize(width, height);
+	}
+
+	~TileMap() = default;
+
+	// 重新设置地图尺寸，所有瓦片恢复默认值
+	void resize(size_t width, size_t height)
+	{
+		this->width = width;
+		this->height = height;
+		tile_list.assign(width * height, Tile());
+	}
+
+	// 直接接管按行优先排列好的瓦片数组，避免先填充默认值再覆盖
+	void assign(size_t width, size_t height, std::vector<Tile> &&tile_list)
+	{
+		this->width = width;
+		this->height = height;
+		this->tile_list = std::move(tile_list);
+		this->tile_list.resize(width * height);
+	}
+
+	size_t get_width() const
+	{
+		return width;
+	}
+
+	size_t get_height() const
+	{
+		return height;
+	}
+
+	bool empty() const
+	{
+		return tile_list.empty();
+	}
+
+	// 检查瓦片坐标是否在地图内
+	bool is_inside(const SDL_Point &idx) const
+	{
+		return idx.x >= 0 && idx.y >= 0 && idx.x < (int)width && idx.y < (int)height;
+	}
+
+	Tile &at(int x, int y)
+	{
+		return tile_list[y * width + x];
+	}
+
+	const Tile &at(int x, int y) const
+	{
+		return tile_list[y * width + x];
+	}
+
+	Tile &at(const SDL_Point &idx)
+	{
+		return at(idx.x, idx.y);
+	}
+
+	const Tile &at(const SDL_Point &idx) const
+	{
+		return at(idx.x, idx.y);
+	}
+
+	// 获取按行优先存放的瓦片数组
+	const std::vector<Tile> &get_tile_list() const
+	{
+		return tile_list;
+	}
+
+	std::vector<Tile> &get_tile_list()
+	{
+		return tile_list;
+	}
+
+private:
+	size_t width = 0;            // 地图宽度（瓦片）
+	size_t height = 0;           // 地图高度（瓦片）
+	std::vector<Tile> tile_list; // 按行优先存放的瓦片
+};
 
 #endif // !_TILE_H_
@@ -0,0 +1,223 @@
+#ifndef _TILE_MAP_RENDERER_H_
+#define _TILE_MAP_RENDERER_H_
+
+#include "game_map/map.h"
+#include "game_map/tile.h"
+
+#include <SDL.h>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+// 每个区块包含的瓦片数（边长）
+#define SIZE_CHUNK 16
+
+// 瓦片地图渲染器：把地图切分为固定大小的区块分别烘焙为纹理
+// 功能包括：
+// 1. 区块缓存：每个区块一张渲染目标纹理，单张纹理尺寸与地图大小无关
+// 2. 脏标记：瓦片变化时只重新烘焙所在区块
+// 3. 视口裁剪：只烘焙和绘制与视口相交的区块
+class TileMapRenderer
+{
+public:
+     TileMapRenderer() = default;
+
+     ~TileMapRenderer()
+     {
+          for (Chunk &chunk : chunk_list)
+               SDL_DestroyTexture(chunk.texture);
+     }
+
+     // 根据地图尺寸划分区块
+     // @param map: 要渲染的地图
+     // @param tex_tile_set: 瓦片集纹理
+     // @param tex_home: 基地纹理
+     // @return: 初始化成功返回true，否则返回false
+     bool init(const Map &map, SDL_Texture *tex_tile_set, SDL_Texture *tex_home)
+     {
+          if (!tex_tile_set || map.get_width() == 0 || map.get_height() == 0)
+               return false;
+
+          this->map = &map;
+          this->tex_tile_set = tex_tile_set;
+          this->tex_home = tex_home;
+
+          int width_tex_tile_set, height_tex_tile_set;
+          SDL_QueryTexture(tex_tile_set, nullptr, nullptr, &width_tex_tile_set, &height_tex_tile_set);
+          num_tile_single_line = std::max(1, (int)std::ceil((double)width_tex_tile_set / SIZE_TILE));
+
+          num_chunk_x = ((int)map.get_width() + SIZE_CHUNK - 1) / SIZE_CHUNK;
+          num_chunk_y = ((int)map.get_height() + SIZE_CHUNK - 1) / SIZE_CHUNK;
+          chunk_list.assign(num_chunk_x * num_chunk_y, Chunk());
+
+          return true;
+     }
+
+     // 标记瓦片所在区块需要重新烘焙
+     // @param idx_tile: 发生变化的瓦片坐标
+     void mark_dirty(const SDL_Point &idx_tile)
+     {
+          if (idx_tile.x < 0 || idx_tile.y < 0)
+               return;
+
+          int idx_chunk_x = idx_tile.x / SIZE_CHUNK, idx_chunk_y = idx_tile.y / SIZE_CHUNK;
+          if (idx_chunk_x >= num_chunk_x || idx_chunk_y >= num_chunk_y)
+               return;
+
+          chunk_list[idx_chunk_y * num_chunk_x + idx_chunk_x].is_dirty = true;
+     }
+
+     // 标记所有区块需要重新烘焙（例如渲染目标丢失后）
+     void mark_all_dirty()
+     {
+          for (Chunk &chunk : chunk_list)
+               chunk.is_dirty = true;
+     }
+
+     // 渲染与视口相交的区块，必要时先重新烘焙
+     // @param renderer: SDL渲染器
+     // @param rect_tile_map: 地图在屏幕上的位置
+     // @param rect_view: 视口区域（屏幕坐标）
+     void on_render(SDL_Renderer *renderer, const SDL_Rect &rect_tile_map, const SDL_Rect &rect_view)
+     {
+          static const int size_chunk_pixel = SIZE_CHUNK * SIZE_TILE;
+
+          // 计算与视口相交的区块范围（向下取整，视口在地图左上方时结果为负）
+          int idx_begin_x = std::max(0, (int)std::floor((double)(rect_view.x - rect_tile_map.x) / size_chunk_pixel));
+          int idx_begin_y = std::max(0, (int)std::floor((double)(rect_view.y - rect_tile_map.y) / size_chunk_pixel));
+          int idx_end_x = std::min(num_chunk_x - 1, (int)std::floor((double)(rect_view.x + rect_view.w - rect_tile_map.x) / size_chunk_pixel));
+          int idx_end_y = std::min(num_chunk_y - 1, (int)std::floor((double)(rect_view.y + rect_view.h - rect_tile_map.y) / size_chunk_pixel));
+
+          for (int y = idx_begin_y; y <= idx_end_y; y++)
+          {
+               for (int x = idx_begin_x; x <= idx_end_x; x++)
+               {
+                    Chunk &chunk = chunk_list[y * num_chunk_x + x];
+                    if ((!chunk.texture || chunk.is_dirty) && !bake_chunk(renderer, chunk, x, y))
+                         continue;
+
+                    const SDL_Rect rect_dst =
+                        {
+                            rect_tile_map.x + x * size_chunk_pixel,
+                            rect_tile_map.y + y * size_chunk_pixel,
+                            chunk.width, chunk.height};
+                    if (SDL_HasIntersection(&rect_dst, &rect_view))
+                         SDL_RenderCopy(renderer, chunk.texture, nullptr, &rect_dst);
+               }
+          }
+     }
+
+     // 获取已烘焙的区块数量（调试用）
+     int get_baked_chunk_count() const
+     {
+          int count = 0;
+          for (const Chunk &chunk : chunk_list)
+               count += (chunk.texture && !chunk.is_dirty) ? 1 : 0;
+          return count;
+     }
+
+     // 获取并清零上次调用以来重新烘焙的区块数量（调试用）
+     int take_bake_count()
+     {
+          int count = num_bake;
+          num_bake = 0;
+          return count;
+     }
+
+private:
+     // 单个区块：一张纹理加一个脏标记
+     struct Chunk
+     {
+          SDL_Texture *texture = nullptr; // 区块纹理，首次可见时创建
+          int width = 0, height = 0;      // 区块纹理尺寸（像素），地图边缘的区块可能不足SIZE_CHUNK
+          bool is_dirty = true;           // 是否需要重新烘焙
+     };
+
+private:
+     const Map *map = nullptr;             // 要渲染的地图
+     SDL_Texture *tex_tile_set = nullptr;  // 瓦片集纹理
+     SDL_Texture *tex_home = nullptr;      // 基地纹理
+     int num_tile_single_line = 1;         // 瓦片集每行的瓦片数
+     int num_chunk_x = 0, num_chunk_y = 0; // 区块行列数
+     std::vector<Chunk> chunk_list;        // 按行优先存储的区块
+     int num_bake = 0;                     // 上次取出以来重新烘焙的区块数量
+
+private:
+     // 把区块内的瓦片绘制到区块纹理上
+     // @return: 烘焙成功返回true，否则返回false
+     bool bake_chunk(SDL_Renderer *renderer, Chunk &chunk, int idx_chunk_x, int idx_chunk_y)
+     {
+          const TileMap &tile_map = map->get_tile_map();
+
+          int idx_begin_x = idx_chunk_x * SIZE_CHUNK, idx_begin_y = idx_chunk_y * SIZE_CHUNK;
+          int idx_end_x = std::min(idx_begin_x + SIZE_CHUNK, (int)map->get_width());
+          int idx_end_y = std::min(idx_begin_y + SIZE_CHUNK, (int)map->get_height());
+
+          if (!chunk.texture)
+          {
+               chunk.width = (idx_end_x - idx_begin_x) * SIZE_TILE;
+               chunk.height = (idx_end_y - idx_begin_y) * SIZE_TILE;
+               chunk.texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
+                                                 SDL_TEXTUREACCESS_TARGET, chunk.width, chunk.height);
+               if (!chunk.texture)
+                    return false;
+
+               SDL_SetTextureBlendMode(chunk.texture, SDL_BLENDMODE_BLEND);
+          }
+
+          SDL_SetRenderTarget(renderer, chunk.texture);
+          SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+          SDL_RenderClear(renderer);
+
+          for (int y = idx_begin_y; y < idx_end_y; y++)
+          {
+               for (int x = idx_begin_x; x < idx_end_x; x++)
+               {
+                    SDL_Rect rect_src;
+                    const Tile &tile = tile_map.at(x, y);
+
+                    const SDL_Rect &rect_dst =
+                        {
+                            (x - idx_begin_x) * SIZE_TILE, (y - idx_begin_y) * SIZE_TILE,
+                            SIZE_TILE, SIZE_TILE};
+
+                    rect_src =
+                        {
+                            (tile.terrian % num_tile_single_line) * SIZE_TILE,
+                            (tile.terrian / num_tile_single_line) * SIZE_TILE,
+                            SIZE_TILE, SIZE_TILE};
+                    SDL_RenderCopy(renderer, tex_tile_set, &rect_src, &rect_dst);
+
+                    if (tile.decoration >= 0)
+                    {
+                         rect_src =
+                             {
+                                 (tile.decoration % num_tile_single_line) * SIZE_TILE,
+                                 (tile.decoration / num_tile_single_line) * SIZE_TILE,
+                                 SIZE_TILE, SIZE_TILE};
+                         SDL_RenderCopy(renderer, tex_tile_set, &rect_src, &rect_dst);
+                    }
+               }
+          }
+
+          // 基地所在的区块额外绘制基地
+          const SDL_Point &idx_home = map->get_idx_home();
+          if (idx_home.x >= idx_begin_x && idx_home.x < idx_end_x && idx_home.y >= idx_begin_y && idx_home.y < idx_end_y)
+          {
+               const SDL_Rect rect_dst =
+                   {
+                       (idx_home.x - idx_begin_x) * SIZE_TILE, (idx_home.y - idx_begin_y) * SIZE_TILE,
+                       SIZE_TILE, SIZE_TILE};
+               SDL_RenderCopy(renderer, tex_home, nullptr, &rect_dst);
+          }
+
+          SDL_SetRenderTarget(renderer, nullptr);
+
+          chunk.is_dirty = false;
+          num_bake++;
+
+          return true;
+     }
+};
+
+#endif // !_TILE_MAP_RENDERER_H_
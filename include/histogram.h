@@ -0,0 +1,130 @@
+#ifndef _HISTOGRAM_H_
+#define _HISTOGRAM_H_
+
+#include <array>
+#include <limits>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief 固定桶数的线性直方图
+ *
+ * 取值范围[min, max)等分为num_bucket个桶，超出范围的值计入首尾两个桶，
+ * 同时记录样本数、总和、最小值和最大值。记录样本只是一次除法和计数，不分配内存。
+ *
+ * @tparam num_bucket 桶数
+ */
+template <size_t num_bucket>
+class Histogram
+{
+public:
+     /**
+      * @param min 取值范围下限
+      * @param max 取值范围上限
+      */
+     Histogram(double min, double max) : range_min(min), range_max(max)
+     {
+          reset();
+     }
+
+     ~Histogram() = default;
+
+     /**
+      * @brief 清空所有样本
+      */
+     void reset()
+     {
+          bucket_list.fill(0);
+          count = 0;
+          sum = 0;
+          value_min = std::numeric_limits<double>::max();
+          value_max = std::numeric_limits<double>::lowest();
+     }
+
+     /**
+      * @brief 记录一个样本
+      */
+     void add(double value)
+     {
+          bucket_list[get_idx_bucket(value)]++;
+          count++;
+          sum += value;
+          if (value < value_min)
+               value_min = value;
+          if (value > value_max)
+               value_max = value;
+     }
+
+     /**
+      * @brief 估计百分位数，返回样本所在桶的上界（不超过实际最大值）
+      * @param ratio 百分位（0-1）
+      */
+     double get_percentile(double ratio) const
+     {
+          if (count == 0)
+               return 0;
+
+          uint64_t num_target = (uint64_t)(ratio * count);
+          if (num_target >= count)
+               num_target = count - 1;
+
+          uint64_t num_accumulated = 0;
+          for (size_t i = 0; i < num_bucket; i++)
+          {
+               num_accumulated += bucket_list[i];
+               if (num_accumulated > num_target)
+                    return std::min(get_bucket_upper(i), value_max);
+          }
+
+          return value_max;
+     }
+
+     uint64_t get_count() const { return count; }
+     double get_sum() const { return sum; }
+     double get_mean() const { return count ? sum / count : 0; }
+     double get_min() const { return count ? value_min : 0; }
+     double get_max() const { return count ? value_max : 0; }
+
+     /**
+      * @brief 获取第idx个桶的样本数
+      */
+     uint64_t get_bucket(size_t idx) const
+     {
+          return bucket_list[idx];
+     }
+
+     /**
+      * @brief 获取第idx个桶的上界
+      */
+     double get_bucket_upper(size_t idx) const
+     {
+          return range_min + (range_max - range_min) * (idx + 1) / num_bucket;
+     }
+
+     static constexpr size_t get_num_bucket()
+     {
+          return num_bucket;
+     }
+
+private:
+     double range_min = 0;                         ///< 取值范围下限
+     double range_max = 1;                         ///< 取值范围上限
+     std::array<uint64_t, num_bucket> bucket_list; ///< 每个桶的样本数
+     uint64_t count = 0;                           ///< 样本数
+     double sum = 0;                               ///< 样本总和
+     double value_min = 0;                         ///< 最小样本
+     double value_max = 0;                         ///< 最大样本
+
+private:
+     size_t get_idx_bucket(double value) const
+     {
+          if (value <= range_min)
+               return 0;
+
+          size_t idx = (size_t)((value - range_min) / (range_max - range_min) * num_bucket);
+          return idx < num_bucket ? idx : num_bucket - 1;
+     }
+};
+
+#endif // !_HISTOGRAM_H_
@@ -0,0 +1,232 @@
+#ifndef _JOB_SYSTEM_H_
+#define _JOB_SYSTEM_H_
+
+#include "manager/manager.h"
+
+#include <mutex>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <atomic>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+// 任务系统：基于工作窃取的线程池，用于把实体更新拆分为并行任务
+// 功能包括：
+// 1. 工作窃取：每个线程有自己的任务队列，空闲时从其他线程的队列头部窃取任务
+// 2. 并行循环：parallel_for按固定粒度把区间切分为区块，调用线程也参与执行
+// 3. 确定性：区块划分只取决于元素数量和粒度，与线程数和调度顺序无关，
+//    并行阶段产生的副作用写入CommandBuffer，按区块顺序统一执行
+class JobSystem : public Manager<JobSystem>
+{
+     friend class Manager<JobSystem>;
+
+public:
+     // 区间任务：处理[begin, end)范围内的元素
+     typedef std::function<void(size_t begin, size_t end)> RangeFunc;
+
+public:
+     // 并行处理[0, count)范围内的元素，返回时所有区块均已完成
+     // @param count: 元素数量
+     // @param grain: 每个区块的元素数量
+     // @param func: 区块处理函数
+     void parallel_for(size_t count, size_t grain, const RangeFunc &func)
+     {
+          if (count == 0)
+               return;
+
+          grain = std::max<size_t>(grain, 1);
+          size_t num_chunk = (count + grain - 1) / grain;
+
+          // 只有一个区块、没有工作线程或在任务内部嵌套调用时直接在当前线程执行
+          if (num_chunk == 1 || worker_list.empty() || get_idx_queue_self() != idx_queue_none)
+          {
+               for (size_t idx_chunk = 0; idx_chunk < num_chunk; idx_chunk++)
+                    run_chunk(func, idx_chunk, grain, count);
+               return;
+          }
+
+          std::atomic<size_t> num_remain(num_chunk);
+
+          // 按区块轮流分配到各个队列，调用线程使用最后一个队列
+          for (size_t idx_chunk = 0; idx_chunk < num_chunk; idx_chunk++)
+          {
+               WorkQueue &queue = *queue_list[idx_chunk % queue_list.size()];
+               std::lock_guard<std::mutex> lock(queue.mutex);
+               queue.job_list.push_back(
+                   [&func, &num_remain, idx_chunk, grain, count]()
+                   {
+                        run_chunk(func, idx_chunk, grain, count);
+                        num_remain.fetch_sub(1, std::memory_order_release);
+                   });
+          }
+
+          {
+               std::lock_guard<std::mutex> lock(mutex_wake);
+               num_pending += num_chunk;
+          }
+          cv_wake.notify_all();
+
+          // 调用线程也参与执行，直到所有区块完成
+          size_t idx_caller = queue_list.size() - 1;
+          get_idx_queue_self() = idx_caller;
+          while (num_remain.load(std::memory_order_acquire) > 0)
+          {
+               Job job;
+               if (try_pop_job(idx_caller, job))
+                    job();
+               else
+                    std::this_thread::yield();
+          }
+          get_idx_queue_self() = idx_queue_none;
+     }
+
+     // 获取工作线程数量（不含调用线程）
+     size_t get_num_worker() const
+     {
+          return worker_list.size();
+     }
+
+     // 当前线程是否正在执行parallel_for的区块
+     static bool is_in_parallel_region()
+     {
+          return get_idx_chunk_current() != idx_chunk_none;
+     }
+
+     // 当前线程正在执行的区块索引，不在并行区域内时无意义
+     static size_t get_current_chunk()
+     {
+          return get_idx_chunk_current();
+     }
+
+protected:
+     JobSystem()
+     {
+          // 模拟线程本身参与执行，渲染线程另占一个核心
+          unsigned int num_core = std::max(1u, std::thread::hardware_concurrency());
+          size_t num_worker = num_core > 2 ? num_core - 2 : 1;
+
+          for (size_t i = 0; i < num_worker + 1; i++)
+               queue_list.emplace_back(new WorkQueue());
+
+          for (size_t i = 0; i < num_worker; i++)
+               worker_list.emplace_back(&JobSystem::run_worker, this, i);
+     }
+
+     ~JobSystem()
+     {
+          {
+               std::lock_guard<std::mutex> lock(mutex_wake);
+               is_stop = true;
+          }
+          cv_wake.notify_all();
+
+          for (std::thread &worker : worker_list)
+               worker.join();
+     }
+
+private:
+     typedef std::function<void()> Job;
+
+     // 单个线程的任务队列：所有者从尾部取，窃取者从头部取
+     struct WorkQueue
+     {
+          std::mutex mutex;
+          std::deque<Job> job_list;
+     };
+
+private:
+     static constexpr size_t idx_queue_none = (size_t)-1;
+     static constexpr size_t idx_chunk_none = (size_t)-1;
+
+     std::vector<std::unique_ptr<WorkQueue>> queue_list; // 每个工作线程一个队列，最后一个属于调用线程
+     std::vector<std::thread> worker_list;               // 工作线程
+
+     std::mutex mutex_wake;
+     std::condition_variable cv_wake;
+     size_t num_pending = 0; // 尚未被取走的任务数，受mutex_wake保护
+     bool is_stop = false;   // 是否停止工作线程，受mutex_wake保护
+
+private:
+     // 当前线程所属的队列索引
+     static size_t &get_idx_queue_self()
+     {
+          static thread_local size_t idx_queue = idx_queue_none;
+          return idx_queue;
+     }
+
+     // 当前线程正在执行的区块索引
+     static size_t &get_idx_chunk_current()
+     {
+          static thread_local size_t idx_chunk = idx_chunk_none;
+          return idx_chunk;
+     }
+
+     // 执行单个区块，执行期间记录区块索引供CommandBuffer使用
+     static void run_chunk(const RangeFunc &func, size_t idx_chunk, size_t grain, size_t count)
+     {
+          size_t &idx_chunk_current = get_idx_chunk_current();
+          size_t idx_chunk_last = idx_chunk_current;
+
+          idx_chunk_current = idx_chunk;
+          func(idx_chunk * grain, std::min(count, (idx_chunk + 1) * grain));
+          idx_chunk_current = idx_chunk_last;
+     }
+
+     // 先从自己的队列尾部取任务，没有则依次从其他队列头部窃取
+     bool try_pop_job(size_t idx_self, Job &job)
+     {
+          for (size_t i = 0; i < queue_list.size(); i++)
+          {
+               size_t idx_queue = (idx_self + i) % queue_list.size();
+               WorkQueue &queue = *queue_list[idx_queue];
+
+               std::lock_guard<std::mutex> lock(queue.mutex);
+               if (queue.job_list.empty())
+                    continue;
+
+               if (i == 0)
+               {
+                    job = std::move(queue.job_list.back());
+                    queue.job_list.pop_back();
+               }
+               else
+               {
+                    job = std::move(queue.job_list.front());
+                    queue.job_list.pop_front();
+               }
+
+               std::lock_guard<std::mutex> lock_wake(mutex_wake);
+               num_pending--;
+               return true;
+          }
+
+          return false;
+     }
+
+     // 工作线程主循环：有任务时执行，没有任务时休眠等待唤醒
+     void run_worker(size_t idx_queue)
+     {
+          get_idx_queue_self() = idx_queue;
+
+          while (true)
+          {
+               Job job;
+               if (try_pop_job(idx_queue, job))
+               {
+                    job();
+                    continue;
+               }
+
+               std::unique_lock<std::mutex> lock(mutex_wake);
+               cv_wake.wait(lock, [this]()
+                            { return is_stop || num_pending > 0; });
+               if (is_stop)
+                    return;
+          }
+     }
+};
+
+#endif // !_JOB_SYSTEM_H_
@@ -0,0 +1,211 @@
+#ifndef _AUDIO_MANAGER_H_
+#define _AUDIO_MANAGER_H_
+
+// 包含必要的头文件
+#include "manager.h"           // 基础管理器模板，实现单例模式
+#include "resources_manager.h" // 资源管理器，用于获取音效资源
+#include "game_map/vector2.h"  // 向量类，用于计算声源与听者的距离
+
+#include <SDL.h>
+#include <SDL_mixer.h>
+#include <array>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+// 音效管理器：统一调度所有音效的播放
+// 功能包括：
+// 1. 声道预算：固定数量的声道，混音开销与防御塔数量无关
+// 2. 并发限制：每种音效（ResID）同时播放的实例数有上限
+// 3. 帧内去重：同一帧内同一音效只播放一次
+// 4. 优先级抢占：声道耗尽时，高优先级音效可以打断低优先级音效
+// 5. 距离衰减：根据声源与听者的距离调整音量，过远的声源直接丢弃
+class AudioManager : public Manager<AudioManager>
+{
+     friend class Manager<AudioManager>;
+
+public:
+     // 音效优先级：数值越大越重要
+     enum class Priority
+     {
+          Low = 0,  // 高频战斗音效：开火、命中
+          Normal,   // 一般反馈音效：金币、爆炸
+          High,     // 玩家操作与关键提示：技能、放置、升级、基地受伤
+          Critical  // 游戏状态音效：胜利、失败，永远不会被丢弃
+     };
+
+     // 单个音效的播放规则
+     struct SoundRule
+     {
+          int max_instances = 2;               // 同时播放的最大实例数
+          Priority priority = Priority::Normal; // 优先级
+     };
+
+public:
+     // 每帧调用一次：清空帧内去重记录
+     // @param delta: 时间增量，单位：秒
+     void on_update(double delta)
+     {
+          std::fill(played_this_frame.begin(), played_this_frame.end(), false);
+     }
+
+     // 设置听者位置（通常为屏幕中心）
+     void set_listener_position(const Vector2 &position)
+     {
+          listener_position = position;
+     }
+
+     // 播放非定位音效（UI、基地等）
+     // @param id: 音效资源ID
+     // @return: 成功播放返回使用的声道，否则返回-1
+     int play_sound(ResID id)
+     {
+          return play_sound_internal(id, 0);
+     }
+
+     // 播放带位置的音效，音量随与听者的距离衰减
+     // @param id: 音效资源ID
+     // @param position: 声源位置
+     // @return: 成功播放返回使用的声道，否则返回-1
+     int play_sound(ResID id, const Vector2 &position)
+     {
+          double distance = (position - listener_position).length();
+          if (distance >= max_audible_distance)
+               return -1;
+
+          return play_sound_internal(id, (Uint8)(distance / max_audible_distance * 255));
+     }
+
+protected:
+     AudioManager()
+     {
+          Mix_AllocateChannels(num_voice);
+          voice_list.resize(num_voice);
+
+          // 高频战斗音效：数量多但单个不重要
+          sound_rule_pool[ResID::Sound_ArrowFire_1] = {3, Priority::Low};
+          sound_rule_pool[ResID::Sound_ArrowFire_2] = {3, Priority::Low};
+          sound_rule_pool[ResID::Sound_AxeFire] = {3, Priority::Low};
+          sound_rule_pool[ResID::Sound_ShellFire] = {2, Priority::Low};
+          sound_rule_pool[ResID::Sound_ArrowHit_1] = {2, Priority::Low};
+          sound_rule_pool[ResID::Sound_ArrowHit_2] = {2, Priority::Low};
+          sound_rule_pool[ResID::Sound_ArrowHit_3] = {2, Priority::Low};
+          sound_rule_pool[ResID::Sound_AxeHit_1] = {2, Priority::Low};
+          sound_rule_pool[ResID::Sound_AxeHit_2] = {2, Priority::Low};
+          sound_rule_pool[ResID::Sound_AxeHit_3] = {2, Priority::Low};
+          sound_rule_pool[ResID::Sound_ShellHit] = {3, Priority::Normal};
+          sound_rule_pool[ResID::Sound_Coin] = {3, Priority::Normal};
+
+          // 玩家操作与关键提示
+          sound_rule_pool[ResID::Sound_Flash] = {1, Priority::High};
+          sound_rule_pool[ResID::Sound_Impact] = {1, Priority::High};
+          sound_rule_pool[ResID::Sound_HomeHurt] = {2, Priority::High};
+          sound_rule_pool[ResID::Sound_PlaceTower] = {1, Priority::High};
+          sound_rule_pool[ResID::Sound_TowerLevelUp] = {1, Priority::High};
+
+          // 游戏状态音效
+          sound_rule_pool[ResID::Sound_Win] = {1, Priority::Critical};
+          sound_rule_pool[ResID::Sound_Loss] = {1, Priority::Critical};
+     }
+
+     ~AudioManager() = default;
+
+private:
+     // 声道上正在播放的音效信息
+     struct Voice
+     {
+          ResID id = ResID::Sound_Coin;         // 音效资源ID
+          Priority priority = Priority::Normal; // 优先级
+          Uint64 start_tick = 0;                // 开始播放的时间，用于抢占最旧的声音
+     };
+
+private:
+     const int num_voice = 24;                  // 声道数量，即混音开销的上限
+     const double max_audible_distance = 1200; // 最大可听距离（像素）
+
+     std::vector<Voice> voice_list;                      // 按声道索引的音效信息
+     std::array<bool, (size_t)ResID::Count> played_this_frame = {}; // 本帧已播放的音效，按资源ID索引
+     std::unordered_map<ResID, SoundRule> sound_rule_pool; // 音效播放规则
+     Vector2 listener_position;                          // 听者位置
+
+private:
+     // 按规则挑选声道并播放音效
+     // @param id: 音效资源ID
+     // @param distance: 衰减距离（0为最近，255为最远）
+     // @return: 成功播放返回使用的声道，否则返回-1
+     int play_sound_internal(ResID id, Uint8 distance)
+     {
+          static const ResourcesManager::SoundPool &sound_pool = ResourcesManager::instance()->get_sound_pool();
+
+          const auto &itor_chunk = sound_pool.find(id);
+          if (itor_chunk == sound_pool.end())
+               return -1;
+
+          // 帧内去重：同一帧内同一音效只播放一次
+          if (played_this_frame[(size_t)id])
+               return -1;
+
+          SoundRule rule;
+          const auto &itor_rule = sound_rule_pool.find(id);
+          if (itor_rule != sound_rule_pool.end())
+               rule = itor_rule->second;
+
+          // 统计同一音效正在播放的实例，同时寻找空闲声道和可抢占声道
+          int num_instances = 0;
+          int idx_free = -1, idx_steal = -1, idx_oldest_same = -1;
+          for (int i = 0; i < num_voice; i++)
+          {
+               if (!Mix_Playing(i))
+               {
+                    if (idx_free < 0)
+                         idx_free = i;
+                    continue;
+               }
+
+               const Voice &voice = voice_list[i];
+               if (voice.id == id)
+               {
+                    num_instances++;
+                    if (idx_oldest_same < 0 || voice.start_tick < voice_list[idx_oldest_same].start_tick)
+                         idx_oldest_same = i;
+               }
+
+               if (voice.priority < rule.priority &&
+                   (idx_steal < 0 || voice.priority < voice_list[idx_steal].priority ||
+                    (voice.priority == voice_list[idx_steal].priority && voice.start_tick < voice_list[idx_steal].start_tick)))
+                    idx_steal = i;
+          }
+
+          int channel = -1;
+          if (num_instances >= rule.max_instances)
+          {
+               // 达到并发上限：只有关键音效会替换掉最旧的同类实例，其余直接丢弃
+               if (rule.priority != Priority::Critical)
+                    return -1;
+               channel = idx_oldest_same;
+          }
+          else if (idx_free >= 0)
+               channel = idx_free;
+          else if (idx_steal >= 0)
+               channel = idx_steal;
+          else
+               return -1;
+
+          Mix_HaltChannel(channel);
+          Mix_SetDistance(channel, distance);
+          channel = Mix_PlayChannel(channel, itor_chunk->second, 0);
+          if (channel < 0)
+               return -1;
+
+          Voice &voice = voice_list[channel];
+          voice.id = id;
+          voice.priority = rule.priority;
+          voice.start_tick = SDL_GetTicks64();
+
+          played_this_frame[(size_t)id] = true;
+
+          return channel;
+     }
+};
+
+#endif // !_AUDIO_MANAGER_H_
@@ -8,6 +8,9 @@
 #include "bullet/axe_bullet.h"   // 斧头子弹
 #include "bullet/shell_bullet.h" // 炮弹子弹
 #include "bullet/bullet_type.h"  // 子弹类型枚举
+#include "job_system.h"          // 任务系统，用于并行更新子弹
+#include "command_buffer.h"      // 指令缓冲，用于结算子弹生成
+#include "slot_map.h"            // 带代际句柄的实体容器
 
 #include <vector>
 #include <iostream>
@@ -24,29 +27,48 @@ class BulletManager : public Manager<BulletManager>
 
 public:
      // 子弹列表类型定义
-     typedef std::vector<Bullet *> BulletList;
+     typedef SlotMap<Bullet *> BulletList;
 
 public:
      // 更新所有子弹的状态
      // @param delta: 时间增量（秒）
+     // @param enemy_list: 敌人列表，追踪子弹通过句柄查询目标（只读）
      // 功能：
-     // 1. 更新每个子弹的位置、动画等
-     // 2. 清理无效的子弹
-     void on_update(double delta)
+     // 并行更新每个子弹的追踪方向、位置、动画等（只修改子弹自身），无效子弹在同步点之后清理
+     void on_update(double delta, const SlotMap<Enemy *> &enemy_list)
      {
-          for (Bullet *bullet : bullet_list)
-               bullet->on_update(delta);
+          static JobSystem *job_system = JobSystem::instance();
+
+          job_system->parallel_for(bullet_list.size(), grain_update,
+                                   [&](size_t begin, size_t end)
+                                   {
+                                        for (size_t i = begin; i < end; i++)
+                                        {
+                                             Bullet *bullet = bullet_list[i];
+                                             if (bullet->is_homing() && bullet->can_collide())
+                                                  track_target(bullet, enemy_list);
+                                             bullet->on_update(delta);
+                                        }
+                                   });
+     }
 
-          remove_invalid_bullet();
+     // 结算子弹生成指令
+     // @param command: 子弹生成指令
+     void apply_spawn_bullet(const CommandBuffer::SpawnBullet &command)
+     {
+          Bullet *bullet = create_bullet(command.type, command.position, command.target_position, command.damage, command.damage_range, command.velocity);
+          bullet->set_target_enemy(command.enemy_target);
+          bullet->set_tower_source(command.tower_source);
      }
 
      // 渲染所有子弹
-     // @param renderer: SDL渲染器
+     // @param snapshot: 渲染快照
+     // @param camera: 摄像机，视图外的子弹不会绘制
      // 功能：调用每个子弹的渲染方法
-     void on_render(SDL_Renderer *renderer)
+     void on_render(RenderSnapshot &snapshot, const Camera &camera)
      {
           for (Bullet *bullet : bullet_list)
-               bullet->on_render(renderer);
+               bullet->on_render(snapshot, camera);
      }
 
      // 获取子弹列表
@@ -61,13 +83,14 @@ public:
      // @param position: 子弹的初始位置
      // @param target_position: 子弹的目标位置
      // @param damage: 子弹的伤害值
-     // @param damage_range: 子弹的伤害范围（-1表示单体伤害）
+     // @param damage_range: 子弹的伤害范围（-1表示使用子弹类型自身的伤害范围）
      // @param velocity: 子弹的速度向量
      // 功能：
      // 1. 根据类型创建对应的子弹对象
      // 2. 设置子弹的初始属性
      // 3. 将子弹添加到管理列表中
-     void create_bullet(BulletType type, const Vector2 &position, const Vector2 &target_position, double damage, double damage_range = -1, const Vector2 &velocity = Vector2())
+     // @return: 新创建的子弹
+     Bullet *create_bullet(BulletType type, const Vector2 &position, const Vector2 &target_position, double damage, double damage_range = -1, const Vector2 &velocity = Vector2())
      {
           Bullet *bullet = nullptr;
 
@@ -92,10 +115,29 @@ public:
           else
                bullet->set_target_position(target_position);
           bullet->set_damage(damage);
-          bullet->set_damage_range(damage_range);
+          if (damage_range >= 0)
+               bullet->set_damage_range(damage_range);
 
           // 添加到管理列表
-          bullet_list.push_back(bullet);
+          bullet_list.insert(bullet);
+
+          return bullet;
+     }
+
+     // 移除无效的子弹，在同步点之后调用
+     // 功能：
+     // 1. 遍历子弹列表
+     // 2. 删除并移除已标记为无效的子弹
+     // 3. 释放子弹对象的内存
+     void remove_invalid_bullet()
+     {
+          bullet_list.remove_if([](const Bullet *bullet)
+                                {
+                                     bool deletable = !bullet->is_valid();
+                                     if (deletable)
+                                          delete bullet;
+                                     return deletable;
+                                });
      }
 
 protected:
@@ -110,26 +152,26 @@ protected:
      }
 
 private:
+     // 并行更新时每个区块的子弹数量
+     const size_t grain_update = 64;
+
      // 子弹列表：存储所有活跃的子弹
      BulletList bullet_list;
 
-     // 移除无效的子弹
-     // 功能：
-     // 1. 遍历子弹列表
-     // 2. 删除并移除已标记为无效的子弹
-     // 3. 释放子弹对象的内存
-     void remove_invalid_bullet()
+private:
+     // 追踪子弹的目标：目标仍然存活时朝预判拦截点转向，否则放弃追踪、沿当前方向飞行
+     // @param bullet: 追踪子弹
+     // @param enemy_list: 敌人列表
+     void track_target(Bullet *bullet, const SlotMap<Enemy *> &enemy_list)
      {
-          bullet_list.erase(std::remove_if(
-                                bullet_list.begin(), bullet_list.end(),
-                                [](const Bullet *bullet)
-                                {
-                                     bool deletable = !bullet->is_valid();
-                                     if (deletable)
-                                          delete bullet;
-                                     return deletable;
-                                }),
-                            bullet_list.end());
+          Enemy *const *enemy = enemy_list.find(bullet->get_target_enemy());
+          if (!enemy || (*enemy)->can_remove())
+          {
+               bullet->lose_target();
+               return;
+          }
+
+          bullet->steer_to((*enemy)->get_position(), (*enemy)->get_velocity());
      }
 };
 
@@ -5,6 +5,9 @@
 #include "coin_prop.h"      // 金币道具类
 #include "manager.h"        // 基础管理器模板，实现单例模式
 #include "config_manager.h" // 配置管理器，用于读取初始金币数量
+#include "job_system.h"     // 任务系统，用于并行更新金币道具
+#include "command_buffer.h" // 指令缓冲，用于结算金币掉落
+#include "slot_map.h"       // 带代际句柄的实体容器
 
 #include <vector>
 
@@ -20,7 +23,7 @@ class CoinManager : public Manager<CoinManager>
 
 public:
      // 金币道具列表类型定义
-     typedef std::vector<CoinProp *> CoinPropList;
+     typedef SlotMap<CoinProp *> CoinPropList;
 
 public:
      // 增加金币数量
@@ -28,6 +31,7 @@ public:
      void increase_coin(double val)
      {
           num_coin += val;
+          num_coin_earned += val;
      }
 
      // 减少金币数量
@@ -35,38 +39,59 @@ public:
      void decrease_coin(double val)
      {
           num_coin -= val;
+          num_coin_spent += val;
 
           // 确保金币数量不会小于0
           if (num_coin < 0)
                num_coin = 0;
      }
 
+     // 获取累计获得的金币（不含初始金币）
+     double get_coin_earned() const
+     {
+          return num_coin_earned;
+     }
+
+     // 获取累计花费的金币
+     double get_coin_spent() const
+     {
+          return num_coin_spent;
+     }
+
      // 更新所有金币道具的状态
      // @param delta: 时间增量，单位：秒
      void on_update(double delta)
      {
-          // 更新每个金币道具
-          for (CoinProp *coin_prop : coin_prop_list)
-               coin_prop->on_update(delta);
-
-          // 移除并删除已失效的金币道具
-          coin_prop_list.erase(std::remove_if(coin_prop_list.begin(), coin_prop_list.end(),
-                                              [](CoinProp *coin_prop)
-                                              {
-                                                   bool deletable = coin_prop->can_remove();
-                                                   if (deletable)
-                                                        delete coin_prop;
-                                                   return deletable;
-                                              }),
-                               coin_prop_list.end());
+          static JobSystem *job_system = JobSystem::instance();
+
+          // 并行更新每个金币道具（只修改道具自身）
+          job_system->parallel_for(coin_prop_list.size(), grain_update,
+                                   [&](size_t begin, size_t end)
+                                   {
+                                        for (size_t i = begin; i < end; i++)
+                                             coin_prop_list[i]->on_update(delta);
+                                   });
+     }
+
+     // 移除并删除已失效的金币道具，在同步点之后调用
+     void remove_invalid_coin_prop()
+     {
+          coin_prop_list.remove_if([](CoinProp *coin_prop)
+                                   {
+                                        bool deletable = coin_prop->can_remove();
+                                        if (deletable)
+                                             delete coin_prop;
+                                        return deletable;
+                                   });
      }
 
      // 渲染所有金币道具
-     // @param renderer: SDL渲染器
-     void on_render(SDL_Renderer *renderer)
+     // @param snapshot: 渲染快照
+     // @param camera: 摄像机，视图外的金币不会绘制
+     void on_render(RenderSnapshot &snapshot, const Camera &camera)
      {
           for (CoinProp *coin_prop : coin_prop_list)
-               coin_prop->on_render(renderer);
+               coin_prop->on_render(snapshot, camera);
      }
 
      // 获取当前金币数量
@@ -83,6 +108,14 @@ public:
           return coin_prop_list;
      }
 
+     // 结算金币掉落指令：按概率在指定位置生成金币道具
+     // @param command: 金币掉落指令
+     void apply_spawn_coin(const CommandBuffer::SpawnCoin &command)
+     {
+          if ((double)(rand() % 100) / 100 <= command.ratio)
+               spawn_coin_prop(command.position);
+     }
+
      // 在指定位置生成金币道具
      // @param position: 生成位置
      void spawn_coin_prop(const Vector2 &position)
@@ -92,7 +125,7 @@ public:
           coin_prop->set_position(position);
 
           // 添加到金币道具列表
-          coin_prop_list.push_back(coin_prop);
+          coin_prop_list.insert(coin_prop);
      }
 
 protected:
@@ -110,7 +143,11 @@ protected:
      }
 
 private:
+     const size_t grain_update = 64; // 并行更新时每个区块的金币道具数量
+
      double num_coin = 0;         // 当前金币数量
+     double num_coin_earned = 0;  // 累计获得的金币
+     double num_coin_spent = 0;   // 累计花费的金币
      CoinPropList coin_prop_list; // 金币道具列表
 };
 
@@ -4,6 +4,8 @@
 #include "../game_map/map.h"
 #include "../game_map/wave.h"
 #include "manager.h"
+#include "../config_binding.h"
+#include "../file_watcher.h"
 
 #include <SDL.h>
 #include <string>
@@ -11,6 +13,10 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <atomic>
 
 class ConfigManager : public Manager<ConfigManager>
 {
@@ -22,6 +28,11 @@ public:
           std::string window_title = u8"��ׯ����ս��";
           int window_width = 1280;
           int window_height = 720;
+          bool is_free_pathing = false; // 敌人是否按流场自由寻路（防御塔可阻挡道路）
+          bool is_hot_reload = false;   // 是否在运行时监视配置文件并热重载
+          std::string stats_path;       // 关卡结束时写出统计数据的CSV路径，为空时不写出
+          std::string map_path = "config/map.csv";       // 地图CSV路径，同名的.tdmap不比它旧时优先加载
+          std::string level_path = "config/level.json";  // 关卡配置路径
      };
 
      struct PlayerTemplate
@@ -40,6 +51,9 @@ public:
           double view_range[10] = {5};
           double cost[10] = {50};
           double upgrade_cost[9] = {75};
+          double refund_ratio = 0.5; // 出售时返还的金币比例（相对于在该塔上花费的金币）
+          bool is_homing = false;  // 子弹是否追踪目标
+          bool is_hitscan = false; // 是否为瞬间命中武器（不生成子弹，开火当帧解析命中）
      };
 
      struct EnemyTemplate
@@ -84,152 +98,102 @@ public:
      const double num_coin_per_prop = 10;
 
 public:
+     // 加载关卡配置：顶层为波次数组，按字段表一次解析，出错时给出具体字段路径且不修改已有波次
+     // @param path: 关卡配置文件路径
+     // @return: 加载成功返回true，否则返回false
      bool load_level_config(const std::string &path)
      {
-          std::ifstream file(path);
-
-          if (!file.good())
-               return false;
-
-          std::stringstream str_stream;
-          str_stream << file.rdbuf();
-          file.close();
-
-          cJSON *json_root = cJSON_Parse(str_stream.str().c_str());
-          if (!json_root)
-               return false;
-
-          if (json_root->type != cJSON_Array)
-          {
-               cJSON_Delete(json_root);
-               return false;
-          }
-
-          cJSON *json_wave = nullptr;
-          cJSON_ArrayForEach(json_wave, json_root)
-          {
-               if (json_wave->type != cJSON_Object)
-                    continue;
-
-               wave_list.emplace_back();
-               Wave &wave = wave_list.back();
-
-               cJSON *json_wave_rewards = cJSON_GetObjectItem(json_wave, "rewards");
-               if (json_wave_rewards && json_wave_rewards->type == cJSON_Number)
-                    wave.rawards = json_wave_rewards->valuedouble;
-               cJSON *json_wave_interval = cJSON_GetObjectItem(json_wave, "interval");
-               if (json_wave_interval && json_wave_interval->type == cJSON_Number)
-                    wave.interval = json_wave_interval->valuedouble;
-               cJSON *json_wave_spawn_list = cJSON_GetObjectItem(json_wave, "spawn_list");
-               if (json_wave_spawn_list && json_wave_spawn_list->type == cJSON_Array)
-               {
-                    cJSON *json_spawn_event = nullptr;
-                    cJSON_ArrayForEach(json_spawn_event, json_wave_spawn_list)
-                    {
-                         if (json_spawn_event->type != cJSON_Object)
-                              continue;
-
-                         wave.spawn_event_list.emplace_back();
-                         Wave::SpawnEvent &spawn_event = wave.spawn_event_list.back();
-
-                         cJSON *json_spawn_event_interval = cJSON_GetObjectItem(json_spawn_event, "interval");
-                         if (json_spawn_event_interval && json_spawn_event_interval->type == cJSON_Number)
-                              spawn_event.interval = json_spawn_event_interval->valuedouble;
-                         cJSON *json_spawn_event_spawn_point = cJSON_GetObjectItem(json_spawn_event, "point");
-                         if (json_spawn_event_spawn_point && json_spawn_event_spawn_point->type == cJSON_Number)
-                              spawn_event.spawn_point = json_spawn_event_spawn_point->valueint;
-                         cJSON *json_spawn_event_enemy_type = cJSON_GetObjectItem(json_spawn_event, "enemy");
-                         if (json_spawn_event_enemy_type && json_spawn_event_enemy_type->type == cJSON_String)
-                         {
-                              const std::string str_enemy_type = json_spawn_event_enemy_type->valuestring;
-                              if (str_enemy_type == "Slim")
-                                   spawn_event.enemy_type = EnemyType::Slim;
-                              else if (str_enemy_type == "KingSlim")
-                                   spawn_event.enemy_type = EnemyType::KingSlim;
-                              else if (str_enemy_type == "Skeleton")
-                                   spawn_event.enemy_type = EnemyType::Skeleton;
-                              else if (str_enemy_type == "Goblin")
-                                   spawn_event.enemy_type = EnemyType::Goblin;
-                              else if (str_enemy_type == "GoblinPriest")
-                                   spawn_event.enemy_type = EnemyType::GoblinPriest;
-                         }
-                    }
-
-                    if (wave.spawn_event_list.empty())
-                         wave_list.pop_back();
-               }
-          }
-
-          cJSON_Delete(json_root);
-
-          if (wave_list.empty())
+          std::vector<Wave> wave_list_temp;
+          if (!parse_level_config(path, wave_list_temp))
                return false;
 
+          wave_list.swap(wave_list_temp);
           return true;
      }
 
+     // 加载游戏配置：按字段表一次解析全部模板，出错时给出具体字段路径且不修改已有模板
+     // @param path: 游戏配置文件路径
+     // @return: 加载成功返回true，否则返回false
      bool load_game_config(const std::string &path)
      {
-          std::cout << "[DEBUG] Try to load game config: " << path << std::endl;
-          std::ifstream file(path);
-          if (!file.good())
-          {
-               std::cerr << "[ERROR] Failed to open config file: " << path << std::endl;
+          GameConfig config;
+          if (!parse_game_config(path, config))
                return false;
-          }
 
-          std::stringstream str_stream;
-          str_stream << file.rdbuf();
-          file.close();
+          basic_template = config.basic;
+          apply_game_config(config);
+          return true;
+     }
 
-          std::string content = str_stream.str();
-          std::cout << "[DEBUG] Config file content length: " << content.length() << std::endl;
-          // std::cout << "[DEBUG] Config file content: " << content << std::endl;
+     // 开始热重载：在后台线程监视配置文件，文件保存后在后台重新解析，
+     // 解析成功的结果暂存起来，等模拟线程在帧边界调用apply_hot_reload时再替换
+     // @param path_game_config: 游戏配置文件路径
+     // @param path_level_config: 关卡配置文件路径
+     void start_hot_reload(const std::string &path_game_config, const std::string &path_level_config)
+     {
+          file_watcher.add(path_game_config);
+          file_watcher.add(path_level_config);
+          file_watcher.start(
+              [this, path_game_config, path_level_config](const std::string &path)
+              {
+                   if (path == path_game_config)
+                   {
+                        std::unique_ptr<GameConfig> config = std::make_unique<GameConfig>();
+                        if (!parse_game_config(path, *config))
+                             return;
+
+                        std::lock_guard<std::mutex> lock(mutex_reload);
+                        pending_game_config = std::move(config);
+                   }
+                   else if (path == path_level_config)
+                   {
+                        std::unique_ptr<std::vector<Wave>> wave_list_new = std::make_unique<std::vector<Wave>>();
+                        if (!parse_level_config(path, *wave_list_new))
+                             return;
+
+                        std::lock_guard<std::mutex> lock(mutex_reload);
+                        pending_wave_list = std::move(wave_list_new);
+                   }
+
+                   has_pending_reload = true;
+              });
+     }
 
-          cJSON *json_root = cJSON_Parse(content.c_str());
-          if (!json_root || json_root->type != cJSON_Object)
-          {
-               std::cerr << "[ERROR] Failed to parse JSON or root is not object." << std::endl;
+     // 在帧边界替换热重载得到的新配置，只能在模拟线程中调用
+     // 新模板对之后生成的敌人和子弹生效；防御塔读取的是TowerStatsCache中展开好的属性，
+     // 返回true后由调用方执行TowerManager::refresh_stats()重建缓存，场上的防御塔从下一次开火开始生效；
+     // 已开始和已完成的波次保持不变，只替换之后的波次；窗口等基础配置需要重启才能生效
+     // @param idx_wave_current: 当前波次索引
+     // @return: 有配置被替换时返回true
+     bool apply_hot_reload(int idx_wave_current)
+     {
+          if (!has_pending_reload.exchange(false))
                return false;
+
+          std::unique_ptr<GameConfig> config;
+          std::unique_ptr<std::vector<Wave>> wave_list_new;
+          {
+               std::lock_guard<std::mutex> lock(mutex_reload);
+               config.swap(pending_game_config);
+               wave_list_new.swap(pending_wave_list);
           }
 
-          cJSON *json_basic = cJSON_GetObjectItem(json_root, "basic");
-          cJSON *json_player = cJSON_GetObjectItem(json_root, "player");
-          cJSON *json_tower = cJSON_GetObjectItem(json_root, "tower");
-          cJSON *json_enemy = cJSON_GetObjectItem(json_root, "enemy");
-
-          if (!json_basic)
-               std::cerr << "[ERROR] Missing 'basic' field in config." << std::endl;
-          if (!json_player)
-               std::cerr << "[ERROR] Missing 'player' field in config." << std::endl;
-          if (!json_tower)
-               std::cerr << "[ERROR] Missing 'tower' field in config." << std::endl;
-          if (!json_enemy)
-               std::cerr << "[ERROR] Missing 'enemy' field in config." << std::endl;
-
-          if (!json_basic || !json_player || !json_tower || !json_enemy ||
-              json_basic->type != cJSON_Object || json_player->type != cJSON_Object ||
-              json_tower->type != cJSON_Object || json_enemy->type != cJSON_Object)
+          if (config)
           {
-               std::cerr << "[ERROR] One or more config fields missing or not object type." << std::endl;
-               cJSON_Delete(json_root);
-               return false;
+               apply_game_config(*config);
+               std::cout << "[INFO] Game config reloaded." << std::endl;
           }
 
-          parse_basic_template(basic_template, json_basic);
-          parse_player_template(player_template, json_player);
-          parse_tower_template(archer_template, cJSON_GetObjectItem(json_tower, "archer"));
-          parse_tower_template(axeman_template, cJSON_GetObjectItem(json_tower, "axeman"));
-          parse_tower_template(gunner_template, cJSON_GetObjectItem(json_tower, "gunner"));
-          parse_enemy_template(slim_template, cJSON_GetObjectItem(json_enemy, "slim"));
-          parse_enemy_template(king_slim_template, cJSON_GetObjectItem(json_enemy, "king_slim"));
-          parse_enemy_template(skeleton_template, cJSON_GetObjectItem(json_enemy, "skeleton"));
-          parse_enemy_template(goblin_template, cJSON_GetObjectItem(json_enemy, "goblin"));
-          parse_enemy_template(goblin_priest_template, cJSON_GetObjectItem(json_enemy, "goblin_priest"));
+          if (wave_list_new)
+          {
+               size_t num_wave_keep = std::min(wave_list.size(), (size_t)std::max(idx_wave_current + 1, 0));
+               wave_list.resize(num_wave_keep);
+               for (size_t i = num_wave_keep; i < wave_list_new->size(); i++)
+                    wave_list.push_back(std::move((*wave_list_new)[i]));
+               std::cout << "[INFO] Level config reloaded, " << wave_list.size() << " waves." << std::endl;
+          }
 
-          cJSON_Delete(json_root);
-          std::cout << "[DEBUG] Game config loaded successfully." << std::endl;
-          return true;
+          return config || wave_list_new;
      }
 
 protected:
@@ -237,108 +201,206 @@ protected:
      ~ConfigManager() = default;
 
 private:
-     void parse_basic_template(BasicTemplate &tpl, cJSON *json_root)
+     // config.json的完整内容：先解析到临时对象，全部成功后再替换到各个模板
+     struct TowerTemplateSet
      {
-          if (!json_root || json_root->type != cJSON_Object)
-               return;
-
-          cJSON *json_window_title = cJSON_GetObjectItem(json_root, "window_title");
-          cJSON *json_window_width = cJSON_GetObjectItem(json_root, "window_width");
-          cJSON *json_window_height = cJSON_GetObjectItem(json_root, "window_height");
-
-          if (json_window_title && json_window_title->type == cJSON_String)
-               tpl.window_title = json_window_title->valuestring;
-          if (json_window_width && json_window_width->type == cJSON_Number)
-               tpl.window_width = json_window_width->valueint;
-          if (json_window_height && json_window_height->type == cJSON_Number)
-               tpl.window_height = json_window_height->valueint;
-     }
+          TowerTemplate archer;
+          TowerTemplate axeman;
+          TowerTemplate gunner;
+     };
 
-     void parse_player_template(PlayerTemplate &tpl, cJSON *json_root)
+     struct EnemyTemplateSet
      {
-          if (!json_root || json_root->type != cJSON_Object)
-               return;
-
-          cJSON *json_speed = cJSON_GetObjectItem(json_root, "speed");
-          cJSON *json_normal_attack_interval = cJSON_GetObjectItem(json_root, "normal_attack_interval");
-          cJSON *json_normal_attack_damage = cJSON_GetObjectItem(json_root, "normal_attack_damage");
-          cJSON *json_skill_interval = cJSON_GetObjectItem(json_root, "skill_interval");
-          cJSON *json_skill_damage = cJSON_GetObjectItem(json_root, "skill_damage");
-
-          if (json_speed && json_speed->type == cJSON_Number)
-               tpl.speed = json_speed->valuedouble;
-          if (json_normal_attack_interval && json_normal_attack_interval->type == cJSON_Number)
-               tpl.normal_attack_interval = json_normal_attack_interval->valuedouble;
-          if (json_normal_attack_damage && json_normal_attack_damage->type == cJSON_Number)
-               tpl.normal_attack_damage = json_normal_attack_damage->valuedouble;
-          if (json_skill_interval && json_skill_interval->type == cJSON_Number)
-               tpl.skill_interval = json_skill_interval->valuedouble;
-          if (json_skill_damage && json_skill_damage->type == cJSON_Number)
-               tpl.skill_damage = json_skill_damage->valuedouble;
+          EnemyTemplate slim;
+          EnemyTemplate king_slim;
+          EnemyTemplate skeleton;
+          EnemyTemplate goblin;
+          EnemyTemplate goblin_priest;
+     };
+
+     struct GameConfig
+     {
+          BasicTemplate basic;
+          PlayerTemplate player;
+          TowerTemplateSet tower;
+          EnemyTemplateSet enemy;
+     };
+
+     // 字段表：JSON键、绑定的成员和取值范围
+     static constexpr ConfigField<BasicTemplate> basic_field_list[] = {
+         config_field<&BasicTemplate::window_title>("window_title"),
+         config_field<&BasicTemplate::window_width>("window_width", 1, 16384),
+         config_field<&BasicTemplate::window_height>("window_height", 1, 16384),
+         config_field<&BasicTemplate::is_free_pathing>("free_pathing"),
+         config_field<&BasicTemplate::is_hot_reload>("hot_reload"),
+         config_field<&BasicTemplate::stats_path>("stats_path"),
+         config_field<&BasicTemplate::map_path>("map_path"),
+         config_field<&BasicTemplate::level_path>("level_path"),
+     };
+
+     static constexpr ConfigField<PlayerTemplate> player_field_list[] = {
+         config_field<&PlayerTemplate::speed>("speed", 0, 100),
+         config_field<&PlayerTemplate::normal_attack_interval>("normal_attack_interval", 0, 3600),
+         config_field<&PlayerTemplate::normal_attack_damage>("normal_attack_damage", 0, 1e6),
+         config_field<&PlayerTemplate::skill_interval>("skill_interval", 0, 3600),
+         config_field<&PlayerTemplate::skill_damage>("skill_damage", 0, 1e6),
+     };
+
+     static constexpr ConfigField<TowerTemplate> tower_field_list[] = {
+         config_field<&TowerTemplate::interval>("interval", 0, 3600),
+         config_field<&TowerTemplate::damage>("damage", 0, 1e6),
+         config_field<&TowerTemplate::view_range>("view_range", 0, 100),
+         config_field<&TowerTemplate::cost>("cost", 0, 1e6),
+         config_field<&TowerTemplate::upgrade_cost>("upgrade_cost", 0, 1e6),
+         config_field<&TowerTemplate::refund_ratio>("refund_ratio", 0, 1),
+         config_field<&TowerTemplate::is_homing>("homing"),
+         config_field<&TowerTemplate::is_hitscan>("hitscan"),
+     };
+
+     static constexpr ConfigField<EnemyTemplate> enemy_field_list[] = {
+         config_field<&EnemyTemplate::hp>("hp", 0.01, 1e9),
+         config_field<&EnemyTemplate::speed>("speed", 0, 100),
+         config_field<&EnemyTemplate::damage>("damage", 0, 1e6),
+         config_field<&EnemyTemplate::reward_ratio>("reward_ratio", 0, 1),
+         config_field<&EnemyTemplate::recover_interval>("recover_interval", 0, 3600),
+         config_field<&EnemyTemplate::recover_range>("recover_range", -1, 100),
+         config_field<&EnemyTemplate::recover_intensity>("recover_intensity", 0, 1e6),
+     };
+
+     static constexpr ConfigField<TowerTemplateSet> tower_set_field_list[] = {
+         config_object<&TowerTemplateSet::archer, tower_field_list>("archer"),
+         config_object<&TowerTemplateSet::axeman, tower_field_list>("axeman"),
+         config_object<&TowerTemplateSet::gunner, tower_field_list>("gunner"),
+     };
+
+     static constexpr ConfigField<EnemyTemplateSet> enemy_set_field_list[] = {
+         config_object<&EnemyTemplateSet::slim, enemy_field_list>("slim"),
+         config_object<&EnemyTemplateSet::king_slim, enemy_field_list>("king_slim"),
+         config_object<&EnemyTemplateSet::skeleton, enemy_field_list>("skeleton"),
+         config_object<&EnemyTemplateSet::goblin, enemy_field_list>("goblin"),
+         config_object<&EnemyTemplateSet::goblin_priest, enemy_field_list>("goblin_priest"),
+     };
+
+     static constexpr ConfigField<GameConfig> game_config_field_list[] = {
+         config_object<&GameConfig::basic, basic_field_list>("basic", true),
+         config_object<&GameConfig::player, player_field_list>("player", true),
+         config_object<&GameConfig::tower, tower_set_field_list>("tower", true),
+         config_object<&GameConfig::enemy, enemy_set_field_list>("enemy", true),
+     };
+
+     static constexpr ConfigEnumName enemy_type_name_list[] = {
+         {"Slim", (int)EnemyType::Slim},
+         {"KingSlim", (int)EnemyType::KingSlim},
+         {"Skeleton", (int)EnemyType::Skeleton},
+         {"Goblin", (int)EnemyType::Goblin},
+         {"GoblinPriest", (int)EnemyType::GoblinPriest},
+     };
+
+     static constexpr ConfigField<Wave::SpawnEvent> spawn_event_field_list[] = {
+         config_field<&Wave::SpawnEvent::interval>("interval", 0, 3600),
+         config_field<&Wave::SpawnEvent::spawn_point>("point", 1, INT8_MAX),
+         config_enum<&Wave::SpawnEvent::enemy_type, enemy_type_name_list>("enemy"),
+     };
+
+     static constexpr ConfigField<Wave> wave_field_list[] = {
+         config_field<&Wave::rawards>("rewards", 0, 1e9),
+         config_field<&Wave::interval>("interval", 0, 3600),
+         config_list<&Wave::spawn_event_list, spawn_event_field_list>("spawn_list"),
+     };
+
+private:
+     std::mutex mutex_reload;                              // 保护等待替换的配置
+     std::atomic<bool> has_pending_reload{false};          // 是否有等待替换的配置
+     std::unique_ptr<GameConfig> pending_game_config;      // 后台解析完成、等待替换的游戏配置
+     std::unique_ptr<std::vector<Wave>> pending_wave_list; // 后台解析完成、等待替换的波次
+     FileWatcher file_watcher;                             // 热重载的配置文件监视器，最后声明以便最先析构（先停止后台线程）
+
+private:
+     // 解析游戏配置文件，可在任意线程调用
+     // @param path: 文件路径
+     // @param config: 解析结果
+     bool parse_game_config(const std::string &path, GameConfig &config)
+     {
+          cJSON *json_root = load_json(path);
+          if (!json_root)
+               return false;
+
+          std::string error;
+          bool is_ok = config_bind_object(json_root, config, game_config_field_list, ConfigPath(), error);
+          cJSON_Delete(json_root);
+
+          if (!is_ok)
+               std::cerr << "[ERROR] " << path << ": " << error << std::endl;
+
+          return is_ok;
      }
 
-     void parse_number_array(double *ary, int max_len, cJSON *json_root)
+     // 解析关卡配置文件，可在任意线程调用，没有生成事件的波次会被忽略
+     // @param path: 文件路径
+     // @param wave_list: 解析结果
+     bool parse_level_config(const std::string &path, std::vector<Wave> &wave_list)
      {
-          if (!json_root || json_root->type != cJSON_Array)
-               return;
+          cJSON *json_root = load_json(path);
+          if (!json_root)
+               return false;
 
-          int idx = -1;
-          cJSON *json_element = nullptr;
-          cJSON_ArrayForEach(json_element, json_root)
+          std::string error;
+          bool is_ok = config_bind_list(json_root, wave_list, wave_field_list, ConfigPath(), error);
+          cJSON_Delete(json_root);
+
+          if (!is_ok)
           {
-               idx++;
-               if (json_element->type != cJSON_Number || idx >= max_len)
-                    continue;
+               std::cerr << "[ERROR] " << path << ": " << error << std::endl;
+               return false;
+          }
 
-               ary[idx] = json_element->valuedouble;
+          wave_list.erase(std::remove_if(wave_list.begin(), wave_list.end(),
+                                         [](const Wave &wave)
+                                         { return wave.spawn_event_list.empty(); }),
+                          wave_list.end());
+          if (wave_list.empty())
+          {
+               std::cerr << "[ERROR] " << path << ": level has no waves with spawn events" << std::endl;
+               return false;
           }
+
+          return true;
      }
 
-     void parse_tower_template(TowerTemplate &tpl, cJSON *json_root)
+     // 把游戏配置替换到各个模板（基础配置除外，窗口尺寸等只在启动时生效）
+     void apply_game_config(const GameConfig &config)
      {
-          if (!json_root || json_root->type != cJSON_Object)
-               return;
-
-          cJSON *json_interval = cJSON_GetObjectItem(json_root, "interval");
-          cJSON *json_damage = cJSON_GetObjectItem(json_root, "damage");
-          cJSON *json_view_range = cJSON_GetObjectItem(json_root, "view_range");
-          cJSON *json_cost = cJSON_GetObjectItem(json_root, "cost");
-          cJSON *json_upgrade_cost = cJSON_GetObjectItem(json_root, "upgrade_cost");
-
-          parse_number_array(tpl.interval, 10, json_interval);
-          parse_number_array(tpl.damage, 10, json_damage);
-          parse_number_array(tpl.view_range, 10, json_view_range);
-          parse_number_array(tpl.cost, 10, json_cost);
-          parse_number_array(tpl.upgrade_cost, 9, json_upgrade_cost);
+          player_template = config.player;
+          archer_template = config.tower.archer;
+          axeman_template = config.tower.axeman;
+          gunner_template = config.tower.gunner;
+          slim_template = config.enemy.slim;
+          king_slim_template = config.enemy.king_slim;
+          skeleton_template = config.enemy.skeleton;
+          goblin_template = config.enemy.goblin;
+          goblin_priest_template = config.enemy.goblin_priest;
      }
 
-     void parse_enemy_template(EnemyTemplate &tpl, cJSON *json_root)
+     // 读取并解析JSON文件，失败时输出原因并返回nullptr，成功时由调用者释放
+     // @param path: 文件路径
+     cJSON *load_json(const std::string &path)
      {
-          if (!json_root || json_root->type != cJSON_Object)
-               return;
-
-          cJSON *json_hp = cJSON_GetObjectItem(json_root, "hp");
-          cJSON *json_speed = cJSON_GetObjectItem(json_root, "speed");
-          cJSON *json_damage = cJSON_GetObjectItem(json_root, "damage");
-          cJSON *json_reward_ratio = cJSON_GetObjectItem(json_root, "reward_ratio");
-          cJSON *json_recover_interval = cJSON_GetObjectItem(json_root, "recover_interval");
-          cJSON *json_recover_range = cJSON_GetObjectItem(json_root, "recover_range");
-          cJSON *json_recover_intensity = cJSON_GetObjectItem(json_root, "recover_intensity");
-
-          if (json_hp && json_hp->type == cJSON_Number)
-               tpl.hp = json_hp->valuedouble;
-          if (json_speed && json_speed->type == cJSON_Number)
-               tpl.speed = json_speed->valuedouble;
-          if (json_damage && json_damage->type == cJSON_Number)
-               tpl.damage = json_damage->valuedouble;
-          if (json_reward_ratio && json_reward_ratio->type == cJSON_Number)
-               tpl.reward_ratio = json_reward_ratio->valuedouble;
-          if (json_recover_interval && json_recover_interval->type == cJSON_Number)
-               tpl.recover_interval = json_recover_interval->valuedouble;
-          if (json_recover_range && json_recover_range->type == cJSON_Number)
-               tpl.recover_range = json_recover_range->valuedouble;
-          if (json_recover_intensity && json_recover_intensity->type == cJSON_Number)
-               tpl.recover_intensity = json_recover_intensity->valuedouble;
+          std::ifstream file(path);
+          if (!file.good())
+          {
+               std::cerr << "[ERROR] Failed to open config file: " << path << std::endl;
+               return nullptr;
+          }
+
+          std::stringstream str_stream;
+          str_stream << file.rdbuf();
+          file.close();
+
+          cJSON *json_root = cJSON_Parse(str_stream.str().c_str());
+          if (!json_root)
+               std::cerr << "[ERROR] " << path << ": invalid JSON" << std::endl;
+
+          return json_root;
      }
 };
 
@@ -12,8 +12,14 @@
 #include "enemy/goblin_priest_enemy.h"
 #include "manager/bullet_manager.h"
 #include "manager/coin_manager.h"
+#include "job_system.h"
+#include "command_buffer.h"
+#include "event_bus.h"
+#include "slot_map.h"
+#include "collision.h"
 
 #include <vector>
+#include <algorithm>
 #include <SDL.h>
 #include <iostream>
 
@@ -29,33 +35,91 @@ class EnemyManager : public Manager<EnemyManager>
      friend class Manager<EnemyManager>;
 
 public:
-     // 敌人列表类型定义：存储所有活跃的敌人对象
-     typedef std::vector<Enemy *> EnemyList;
+     // 敌人列表类型定义：存储所有活跃的敌人对象，通过EnemyHandle安全引用
+     typedef SlotMap<Enemy *> EnemyList;
+
+     // 一条伤害指令的结算结果
+     struct DamageResult
+     {
+          double damage = 0; // 实际造成的伤害，不含溢出部分
+          int num_kill = 0;  // 击杀数
+     };
 
 public:
      // 更新所有敌人的状态
      // @param delta: 距离上次更新的时间间隔（秒）
      void on_update(double delta)
      {
-          // 更新每个敌人的状态
-          for (Enemy *enemy : enemy_list)
-               enemy->on_update(delta);
+          static JobSystem *job_system = JobSystem::instance();
+
+          // 并行更新每个敌人的状态（移动、计时器、动画），只修改敌人自身
+          job_system->parallel_for(enemy_list.size(), grain_update,
+                                   [&](size_t begin, size_t end)
+                                   {
+                                        for (size_t i = begin; i < end; i++)
+                                             enemy_list[i]->on_update(delta);
+                                   });
 
           // 处理与基地的碰撞
           process_home_collision();
-          // 处理与子弹的碰撞
+          // 处理与子弹的碰撞，伤害写入指令缓冲，在同步点统一结算
           process_bullet_collision();
+     }
+
+     // 结算治疗指令：恢复范围内所有敌人的生命值
+     // @param command: 治疗指令
+     void apply_heal(const CommandBuffer::Heal &command)
+     {
+          for (Enemy *enemy : enemy_list)
+          {
+               if ((enemy->get_position() - command.position).length() <= command.radius)
+                    enemy->increase_hp(command.intensity);
+          }
+     }
+
+     // 结算伤害指令，已死亡的敌人不再受到伤害，击杀时按敌人的奖励倍率掉落金币
+     // @param command: 伤害指令
+     // @return: 实际造成的伤害和击杀数，用于记入伤害来源
+     DamageResult apply_damage(const CommandBuffer::ApplyDamage &command)
+     {
+          DamageResult result;
+
+          if (!command.enemy_target.is_null())
+          {
+               // 目标在提交指令后已被移除时句柄失效，直接忽略
+               if (Enemy *enemy = get_enemy(command.enemy_target))
+                    damage_enemy(enemy, command, result);
+               return result;
+          }
+
+          for (Enemy *enemy : enemy_list)
+          {
+               if ((enemy->get_position() - command.position).length() <= command.damage_range)
+                    damage_enemy(enemy, command, result);
+          }
+
+          return result;
+     }
 
-          // 移除无效的敌人（已死亡或到达终点）
-          remove_invalid_enemy();
+     // 移除所有无效的敌人（已死亡或到达终点），在同步点之后调用
+     void remove_invalid_enemy()
+     {
+          enemy_list.remove_if([](const Enemy *enemy)
+                               {
+                                    bool deletable = enemy->can_remove();
+                                    if (deletable)
+                                         delete enemy;
+                                    return deletable;
+                               });
      }
 
      // 渲染所有敌人
-     // @param renderer: SDL渲染器
-     void on_render(SDL_Renderer *renderer)
+     // @param snapshot: 渲染快照
+     // @param camera: 摄像机，视图外的敌人不会绘制
+     void on_render(RenderSnapshot &snapshot, const Camera &camera)
      {
           for (auto &enemy : enemy_list)
-               enemy->on_render(renderer);
+               enemy->on_render(snapshot, camera);
      }
 
      // 在指定生成点生成敌人
@@ -63,8 +127,6 @@ public:
      // @param idx_spawn_point: 生成点索引
      void spawn_enemy(EnemyType type, int idx_spawn_point)
      {
-          static Vector2 position;
-          static const SDL_Rect &rect_tile_map = ConfigManager::instance()->rect_tile_map;
           static const Map::SpawnerRoutePool &spawner_route_pool = ConfigManager::instance()->map.get_idx_spawner_pool();
 
           // 检查生成点是否有效
@@ -96,36 +158,30 @@ public:
                enemy = new SlimEnemy();
                break;
           }
+          enemy->set_enemy_type(type);
 
           // 设置敌人的技能释放回调
           // 当敌人释放技能时，会治疗范围内的其他敌人
+          // 技能在并行更新中触发，治疗会修改其他敌人，因此写入指令缓冲在同步点结算
           enemy->set_on_skill_released(
-              [&](Enemy *enemy_src)
+              [](Enemy *enemy_src)
               {
                    double recover_raduis = enemy_src->get_recover_radius();
                    if (recover_raduis < 0)
                         return;
 
-                   const Vector2 pos_src = enemy_src->get_position();
-                   for (Enemy *enemy_dst : enemy_list)
-                   {
-                        const Vector2 &pos_dst = enemy_dst->get_position();
-                        double distance = (pos_dst - pos_src).length();
-                        if (distance <= recover_raduis)
-                             enemy_dst->increase_hp(enemy_src->get_recover_intensity());
-                   }
+                   CommandBuffer::instance()->heal(enemy_src->get_position(), recover_raduis, enemy_src->get_recover_intensity());
               });
 
-          // 设置敌人的初始位置和路径
-          const Route::IdxList &idx_list = itor->second.get_idx_list();
-          position.x = rect_tile_map.x + idx_list[0].x * SIZE_TILE + SIZE_TILE / 2;
-          position.y = rect_tile_map.y + idx_list[0].y * SIZE_TILE + SIZE_TILE / 2;
-
-          enemy->set_position(position);
-          enemy->set_route(&itor->second);
+          // 设置敌人的路径，初始位置为路径起点；自由寻路模式下从生成点出发按流场移动
+          static const Map &map = ConfigManager::instance()->map;
+          if (map.is_free_pathing())
+               enemy->set_flow_field(&map.get_flow_field(), itor->second.get_idx_list()[0]);
+          else
+               enemy->set_route(&itor->second);
 
           // 将新生成的敌人添加到列表中
-          enemy_list.push_back(enemy);
+          enemy_list.insert(enemy);
      }
 
      // 检查是否所有敌人都已被清除
@@ -142,6 +198,15 @@ public:
           return enemy_list;
      }
 
+     // 通过句柄获取敌人
+     // @param handle: 敌人句柄
+     // @return: 敌人对象，已被移除时返回nullptr
+     Enemy *get_enemy(EnemyHandle handle) const
+     {
+          Enemy *const *enemy = enemy_list.find(handle);
+          return enemy ? *enemy : nullptr;
+     }
+
 protected:
      // 构造函数：protected确保只能通过单例模式访问
      EnemyManager() = default;
@@ -154,6 +219,8 @@ protected:
      }
 
 private:
+     const size_t grain_update = 64; // 并行更新时每个区块的敌人数量
+
      EnemyList enemy_list; // 存储所有活跃的敌人对象
 
 private:
@@ -181,87 +248,87 @@ private:
                     enemy->make_invalid();
                     // 对基地造成伤害
                     HomeManager::instance()->decrease_hp(enemy->get_damage());
+                    EventBus::instance()->publish(EnemyReachedHomeEvent{enemy->get_enemy_type(), enemy->get_damage()});
                }
           }
      }
 
      // 处理敌人与子弹的碰撞
      // 当子弹击中敌人时，对敌人造成伤害并可能触发范围伤害
+     // 使用连续碰撞检测：以子弹上一帧位置到当前位置的线段与敌人包围盒求交，
+     // 高速子弹一帧移动距离超过敌人尺寸时也不会穿透；多个敌人相交时命中线段上最先接触的敌人
      void process_bullet_collision()
      {
           static BulletManager::BulletList &bullet_list = BulletManager::instance()->get_bullet_list();
+          static CommandBuffer *command_buffer = CommandBuffer::instance();
 
-          for (Enemy *enemy : enemy_list)
+          for (Bullet *bullet : bullet_list)
           {
-               if (enemy->can_remove())
+               if (!bullet->can_collide())
                     continue;
 
-               const Vector2 &size_enemy = enemy->get_size();
-               const Vector2 &pos_enemy = enemy->get_position();
+               const Vector2 &pos_bullet_last = bullet->get_position_last();
+               const Vector2 &pos_bullet = bullet->get_position();
 
-               for (Bullet *bullet : bullet_list)
+               // 寻找扫掠线段上最先接触的敌人
+               size_t idx_hit = 0;
+               double t_hit_min = 2;
+               for (size_t i = 0; i < enemy_list.size(); i++)
                {
-                    if (!bullet->can_collide())
+                    Enemy *enemy = enemy_list[i];
+                    if (enemy->can_remove())
                          continue;
 
-                    const Vector2 &pos_bullet = bullet->get_position();
-
-                    // 检查子弹是否击中敌人
-                    if (pos_bullet.x >= pos_enemy.x - size_enemy.x / 2 && pos_bullet.y >= pos_enemy.y - size_enemy.y / 2 && pos_bullet.x <= pos_enemy.x + size_enemy.x / 2 && pos_bullet.y <= pos_enemy.y + size_enemy.y / 2)
+                    double t_hit = 0;
+                    if (intersect_segment_aabb(pos_bullet_last, pos_bullet, enemy->get_position(), enemy->get_size(), &t_hit) && t_hit < t_hit_min)
                     {
-                         double damage = bullet->get_damage();
-                         double damage_range = bullet->get_damage_range();
-                         if (damage_range < 0)
-                         {
-                              // 单体伤害
-                              enemy->decrease_hp(damage);
-                              if (enemy->can_remove())
-                                   try_spawn_coin_prop(pos_enemy, enemy->get_reward_ratio());
-                         }
-                         else
-                         {
-                              // 范围伤害
-                              for (Enemy *target_enemy : enemy_list)
-                              {
-                                   const Vector2 &pos_target_enemy = target_enemy->get_position();
-                                   if ((pos_target_enemy - pos_bullet).length() <= damage_range)
-                                   {
-                                        target_enemy->decrease_hp(damage);
-                                        if (target_enemy->can_remove())
-                                             try_spawn_coin_prop(pos_target_enemy, enemy->get_reward_ratio());
-                                   }
-                              }
-                         }
-
-                         bullet->on_collide(enemy);
+                         idx_hit = i;
+                         t_hit_min = t_hit;
                     }
                }
+
+               if (t_hit_min > 1)
+                    continue;
+
+               // 把子弹移动到接触点，范围伤害和命中特效以接触点为中心
+               bullet->set_position(pos_bullet_last + (pos_bullet - pos_bullet_last) * t_hit_min);
+
+               CommandBuffer::ApplyDamage command;
+               command.damage = bullet->get_damage();
+               command.damage_range = bullet->get_damage_range();
+               command.tower_source = bullet->get_tower_source();
+               if (command.damage_range < 0)
+                    command.enemy_target = enemy_list.get_handle(idx_hit); // 单体伤害
+               else
+                    command.position = bullet->get_position(); // 范围伤害
+               command_buffer->apply_damage(command);
+
+               bullet->on_collide(enemy_list[idx_hit]);
           }
      }
 
-     // 移除所有无效的敌人（已死亡或到达终点）
-     void remove_invalid_enemy()
+     // 对单个敌人造成伤害
+     // @param enemy: 目标敌人
+     // @param command: 伤害指令
+     // @param result: 累加实际造成的伤害（不超过敌人剩余生命值）和击杀数
+     void damage_enemy(Enemy *enemy, const CommandBuffer::ApplyDamage &command, DamageResult &result)
      {
-          enemy_list.erase(std::remove_if(enemy_list.begin(), enemy_list.end(),
-                                          [](const Enemy *enemy)
-                                          {
-                                               bool deletable = enemy->can_remove();
-                                               if (deletable)
-                                                    delete enemy;
-                                               return deletable;
-                                          }),
-                           enemy_list.end());
-     }
+          if (enemy->can_remove())
+               return;
 
-     // 尝试在敌人死亡位置生成金币道具
-     // @param position: 生成位置
-     // @param ratio: 生成概率（0-1之间）
-     void try_spawn_coin_prop(const Vector2 &position, double ratio)
-     {
-          static CoinManager *instance = CoinManager::instance();
+          result.damage += std::min(command.damage, enemy->get_hp());
+          enemy->decrease_hp(command.damage);
+          if (command.is_slow_down)
+               enemy->slow_down();
+
+          if (!enemy->can_remove())
+               return;
 
-          if ((double)(rand() % 100) / 100 <= ratio)
-               instance->spawn_coin_prop(position);
+          // 本次伤害击杀了敌人：在死亡位置尝试掉落金币
+          result.num_kill++;
+          EventBus::instance()->publish(EnemyKilledEvent{enemy->get_enemy_type(), enemy->get_position(), command.tower_source, enemy->get_time_alive()});
+          if (command.can_drop_coin)
+               CommandBuffer::instance()->spawn_coin(enemy->get_position(), enemy->get_reward_ratio());
      }
 };
 
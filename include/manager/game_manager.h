@@ -3,22 +3,40 @@
 #define SDL_MAIN_HANDLED
 
 #include "ui/banner.h"
+#include "camera.h"
+#include "game_map/tile_map_renderer.h"
+#include "render_snapshot.h"
+#include "text_cache.h"
+#include "triple_buffer.h"
 #include "manager.h"
 #include "config_manager.h"
 #include "enemy_manager.h"
 #include "wave_manager.h"
 #include "resources_manager.h"
+#include "audio_manager.h"
 #include "tower_manager.h"
 #include "bullet_manager.h"
 #include "ui/status_bar.h"
+#include "ui/debug_overlay.h"
+#include "ui/tile_reject_marker.h"
 #include "ui/panel/panel.h"
 #include "ui/panel/place_panel.h"
 #include "ui/panel/upgrade_panel.h"
+#include "ui/panel/tower_panel.h"
+#include "event_bus.h"
+#include "stats_manager.h"
+#include "simulation_manager.h"
 #include "player_manager.h"
 #include <SDL.h>
 #include <SDL_image.h>
 #include <SDL_ttf.h>
 #include <SDL_mixer.h>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <string>
+#include <filesystem>
 
 // class manages the whole game
 class GameManager : public Manager<GameManager>
@@ -27,43 +45,62 @@ class GameManager : public Manager<GameManager>
 
 public:
     // main running function start game loop
+    // 主线程即渲染线程：负责SDL事件轮询和全部渲染器调用（SDL要求二者都在创建窗口的线程上）
+    // 模拟线程负责游戏逻辑，每帧把结果录制为渲染快照，通过三缓冲交给渲染线程
+    // 这样垂直同步导致的SDL_RenderPresent阻塞只影响渲染线程，不再拖慢模拟
     int run(int argc, char **argv)
     {
-        // 记录初始性能计数器和频率，用于计算每一帧经过的时间
-        Uint64 last_counter = SDL_GetPerformanceCounter();
+        std::thread thread_simulation(&GameManager::run_simulation, this);
+
         const Uint64 counter_freq = SDL_GetPerformanceFrequency();
+        Uint64 counter_present_last = 0;
 
-        // 游戏主循环
         while (!is_quit)
         {
-            // 事件处理：比如键盘、鼠标事件等
-            while (SDL_PollEvent(&event))
-                on_input();
+            Uint64 counter_frame = SDL_GetPerformanceCounter();
 
-            // 当前时间点
-            Uint64 current_counter = SDL_GetPerformanceCounter();
-            // 计算两帧之间的时间差（以秒为单位）
-            double delta = (double)(current_counter - last_counter) / counter_freq;
-            last_counter = current_counter;
+            // 事件处理：主线程轮询，转交给模拟线程处理
+            SDL_Event event;
+            while (SDL_PollEvent(&event))
+            {
+                if (event.type == SDL_QUIT)
+                    is_quit = true;
 
-            // 控制帧率为60 FPS
-            if (delta * 1000.0 > (1000.0 / 60))
-                SDL_Delay((Uint32)(1000.0 / 60 - delta * 1000));
+                std::lock_guard<std::mutex> lock(mutex_event);
+                event_queue.push_back(event);
+            }
 
-            // 更新逻辑，比如物体移动、碰撞检测等
-            on_update(delta);
+            // 取最新的快照，没有新快照时重复绘制上一帧
+            snapshot_buffer.acquire();
 
             // 渲染设置：清除画面并设置背景色为黑色
             SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
             SDL_RenderClear(renderer);
 
-            // 渲染游戏内容（绘制精灵等）
-            on_render();
+            // 渲染游戏内容（绘制精灵等），耗时和创建的纹理数量交给模拟线程的调试层显示
+            Uint64 counter_render = SDL_GetPerformanceCounter();
+            on_render(snapshot_buffer.get_read_buffer());
+            time_render_last = (double)(SDL_GetPerformanceCounter() - counter_render) / counter_freq;
+            num_upload_render += text_cache.take_upload_count() + tile_map_renderer.take_bake_count();
 
-            // 显示渲染结果
+            // 显示渲染结果，两次显示之间的间隔即玩家看到的帧间隔，交给调试层显示
             SDL_RenderPresent(renderer);
+            Uint64 counter_present = SDL_GetPerformanceCounter();
+            if (counter_present_last > 0)
+                time_present_last = (double)(counter_present - counter_present_last) / counter_freq;
+            counter_present_last = counter_present;
+
+            // 没有垂直同步时按显示器刷新率限制帧率，避免渲染线程空转占满CPU
+            if (!is_vsync)
+            {
+                double frame_time = (double)(SDL_GetPerformanceCounter() - counter_frame) / counter_freq;
+                if (frame_time < frame_time_render_min)
+                    SDL_Delay((Uint32)((frame_time_render_min - frame_time) * 1000));
+            }
         }
 
+        thread_simulation.join();
+
         return 0;
     }
 
@@ -82,8 +119,16 @@ protected:
         ConfigManager *config = ConfigManager::instance();
 
         init_assert(ConfigManager::instance()->load_game_config("config/config.json"), "加载游戏配置失败!");
-        init_assert(ConfigManager::instance()->map.load("config/map.csv"), u8"地图加载失败！");
-        init_assert(ConfigManager::instance()->load_level_config("config/level.json"), "加载关卡配置失败!");
+        config->map.set_free_pathing(config->basic_template.is_free_pathing);
+        const std::string &path_map = config->basic_template.map_path;
+        const std::string &path_level = config->basic_template.level_path;
+        init_assert(ConfigManager::instance()->map.load(select_map_path(path_map, std::filesystem::path(path_map).replace_extension(".tdmap").string())), u8"地图加载失败！");
+        init_assert(ConfigManager::instance()->load_level_config(path_level), "加载关卡配置失败!");
+        TowerManager::instance()->refresh_stats();
+        TowerManager::instance()->reset_tower_grid();
+        if (config->basic_template.is_hot_reload)
+            config->start_hot_reload("config/config.json", path_level);
+        StatsManager::instance()->start(config->wave_list.size());
 
         window = SDL_CreateWindow(config->basic_template.window_title.c_str(), SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
                                   config->basic_template.window_width, config->basic_template.window_height, SDL_WINDOW_SHOWN);
@@ -92,15 +137,39 @@ protected:
         renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
         init_assert(renderer, u8"创建渲染器失败！");
 
+        // 驱动不支持垂直同步时由渲染循环自行限制帧率，刷新率未知时按60Hz
+        SDL_RendererInfo renderer_info;
+        is_vsync = !SDL_GetRendererInfo(renderer, &renderer_info) && (renderer_info.flags & SDL_RENDERER_PRESENTVSYNC);
+        SDL_DisplayMode display_mode;
+        int refresh_rate = (!SDL_GetWindowDisplayMode(window, &display_mode) && display_mode.refresh_rate > 0) ? display_mode.refresh_rate : 60;
+        frame_time_render_min = 1.0 / refresh_rate;
+
         init_assert(ResourcesManager::instance()->load_from_file(renderer), u8"加载游戏资源失败！");
 
-        init_assert(generate_tile_map_texture(), u8"生成地图纹理失败！");
+        init_assert(init_tile_map_renderer(), u8"初始化地图渲染器失败！");
+
+        const SDL_Rect &rect_tile_map = config->rect_tile_map;
+        camera.set_view_size(config->basic_template.window_width, config->basic_template.window_height);
+        camera.set_world_rect(rect_tile_map);
+        camera.look_at({rect_tile_map.x + rect_tile_map.w / 2.0, rect_tile_map.y + rect_tile_map.h / 2.0});
 
         status_bar.set_position(15, 15);
+        debug_overlay.set_position(config->basic_template.window_width - 270, 15);
+
+        text_cache.set_font(ResourcesManager::instance()->get_font_pool().find(ResID::Font_Main)->second);
 
         banner = new Banner();
         place_panel = new PlacePanel();
         upgrade_panel = new UpgradePanel();
+        tower_panel = new TowerPanel();
+
+        subscribe_audio_event();
+
+        // 放置或迁移会阻断路线时在目标瓦片上闪烁提示
+        EventBus::instance()->subscribe<TowerPlaceRejectedEvent>(
+            [](void *context, const TowerPlaceRejectedEvent &event)
+            { ((GameManager *)context)->tile_reject_marker.show(event.idx_tile); },
+            this);
     }
 
     // destructor free all resources
@@ -108,6 +177,7 @@ protected:
     {
         delete place_panel;
         delete upgrade_panel;
+        delete tower_panel;
         SDL_DestroyRenderer(renderer);
         SDL_DestroyWindow(window);
         TTF_Quit();
@@ -117,18 +187,37 @@ protected:
     }
 
 private:
-    SDL_Event event;
-    bool is_quit = false;
+    std::atomic<bool> is_quit = false;
 
     StatusBar status_bar;
+    DebugOverlay debug_overlay;
+    TileRejectMarker tile_reject_marker;
+    Camera camera;
+    SDL_Point pos_cursor_world = {0, 0}; // 鼠标在世界空间中的位置，用于迁移防御塔时的预览
 
     SDL_Window *window = nullptr;
     SDL_Renderer *renderer = nullptr;
-
-    SDL_Texture *tex_tile_map = nullptr;
+    bool is_vsync = false;
+    double frame_time_render_min = 1.0 / 60;
+
+    // 以下成员由渲染线程独占
+    TileMapRenderer tile_map_renderer;
+    TextCache text_cache;
+    std::vector<SDL_Point> dirty_tile_list_render;
+
+    // 以下成员用于模拟线程与渲染线程之间的数据交换
+    TripleBuffer<RenderSnapshot> snapshot_buffer;
+    std::mutex mutex_event;
+    std::vector<SDL_Event> event_queue;
+    std::mutex mutex_dirty_tile;
+    std::vector<SDL_Point> dirty_tile_list;
+    std::atomic<double> time_render_last = 0;
+    std::atomic<double> time_present_last = 0;
+    std::atomic<int> num_upload_render = 0;
 
     Panel *place_panel = nullptr;
     Panel *upgrade_panel = nullptr;
+    TowerPanel *tower_panel = nullptr;
     Banner *banner = nullptr;
 
 private:
@@ -141,46 +230,168 @@ private:
         exit(-1);
     }
 
-    void on_input()
+    // 选择要加载的地图文件：由map_convert生成的二进制地图不比CSV旧时优先使用，
+    // 避免编辑CSV后忘记重新转换而加载到过期的地图
+    static std::string select_map_path(const std::string &path_csv, const std::string &path_binary)
+    {
+        std::error_code error;
+        std::filesystem::file_time_type time_binary = std::filesystem::last_write_time(path_binary, error);
+        if (error)
+            return path_csv;
+
+        std::filesystem::file_time_type time_csv = std::filesystem::last_write_time(path_csv, error);
+        if (!error && time_csv > time_binary)
+            return path_csv;
+
+        return path_binary;
+    }
+
+    // 模拟线程主循环
+    void run_simulation()
+    {
+        // 记录初始性能计数器和频率，用于计算每一帧经过的时间
+        Uint64 last_counter = SDL_GetPerformanceCounter();
+        const Uint64 counter_freq = SDL_GetPerformanceFrequency();
+
+        std::vector<SDL_Event> event_list;
+        std::vector<SDL_Point> dirty_tile_list_sim;
+
+        while (!is_quit)
+        {
+            {
+                std::lock_guard<std::mutex> lock(mutex_event);
+                event_list.swap(event_queue);
+            }
+            for (const SDL_Event &event : event_list)
+                on_input(event);
+            event_list.clear();
+
+            // 当前时间点
+            Uint64 current_counter = SDL_GetPerformanceCounter();
+            // 计算两帧之间的时间差（以秒为单位）
+            double delta = (double)(current_counter - last_counter) / counter_freq;
+            last_counter = current_counter;
+
+            // 帧边界：替换后台热重载完成的配置，本帧的更新已经看到新配置
+            if (ConfigManager::instance()->apply_hot_reload(WaveManager::instance()->get_idx_wave()))
+                TowerManager::instance()->refresh_stats();
+
+            // 更新逻辑，比如物体移动、碰撞检测等
+            on_update(delta);
+
+            // 把地图变化转交给渲染线程，由其重新烘焙对应区块
+            ConfigManager::instance()->map.take_dirty_tile_list(dirty_tile_list_sim);
+            if (!dirty_tile_list_sim.empty())
+            {
+                std::lock_guard<std::mutex> lock(mutex_dirty_tile);
+                dirty_tile_list.insert(dirty_tile_list.end(), dirty_tile_list_sim.begin(), dirty_tile_list_sim.end());
+            }
+
+            // 录制并发布本帧的渲染快照
+            RenderSnapshot &snapshot = snapshot_buffer.get_write_buffer();
+            snapshot.clear();
+            on_record(snapshot);
+            snapshot_buffer.publish();
+
+            // 控制帧率为60 FPS：扣除本帧已用时间后休眠剩余部分
+            double frame_time = (double)(SDL_GetPerformanceCounter() - current_counter) / counter_freq;
+            StatsManager::instance()->record_frame_time(frame_time);
+            debug_overlay.record_frame(time_present_last, frame_time, time_render_last, num_upload_render.exchange(0));
+            if (frame_time < 1.0 / 60)
+                SDL_Delay((Uint32)((1.0 / 60 - frame_time) * 1000));
+        }
+    }
+
+    void on_input(const SDL_Event &event)
     {
         static SDL_Point pos_center;
         static SDL_Point idx_tile_selected;
         static ConfigManager *instance = ConfigManager::instance();
 
+        camera.on_input(event);
+
+        // 面板和瓦片都位于世界空间，鼠标坐标先转换为世界坐标
+        SDL_Event event_world = event;
+        if (event.type == SDL_MOUSEMOTION)
+        {
+            Vector2 pos_world = camera.screen_to_world({(double)event.motion.x, (double)event.motion.y});
+            event_world.motion.x = (int)std::floor(pos_world.x);
+            event_world.motion.y = (int)std::floor(pos_world.y);
+            pos_cursor_world = {event_world.motion.x, event_world.motion.y};
+        }
+        else if (event.type == SDL_MOUSEBUTTONDOWN || event.type == SDL_MOUSEBUTTONUP)
+        {
+            Vector2 pos_world = camera.screen_to_world({(double)event.button.x, (double)event.button.y});
+            event_world.button.x = (int)std::floor(pos_world.x);
+            event_world.button.y = (int)std::floor(pos_world.y);
+        }
+
         switch (event.type)
         {
-        case SDL_QUIT:
-            is_quit = true;
+        case SDL_KEYDOWN:
+            if (event.key.keysym.sym == SDLK_F3 && !event.key.repeat)
+                debug_overlay.toggle();
+            else if (event.key.keysym.sym == SDLK_ESCAPE)
+                tower_panel->clear_tower_relocating();
             break;
         case SDL_MOUSEBUTTONDOWN:
-            if (instance->is_game_over)
+        {
+            if (instance->is_game_over || event.button.button == SDL_BUTTON_MIDDLE)
+                break;
+            if (!get_cursor_idx_tile(idx_tile_selected, event_world.button.x, event_world.button.y))
                 break;
-            if (get_cursor_idx_tile(idx_tile_selected, event.motion.x, event.motion.y))
+
+            // 点击迁移后等待左键点击目标瓦片，其他按键和地图外的点击不影响迁移状态；
+            // 点击防御塔所在的瓦片取消迁移，目标无法放置时闪烁提示
+            if (Tower *tower_relocating = TowerManager::instance()->get_tower(tower_panel->get_tower_relocating()))
             {
-                get_selected_tile_center_pos(pos_center, idx_tile_selected);
+                if (event.button.button != SDL_BUTTON_LEFT)
+                    break;
+
+                tower_panel->clear_tower_relocating();
+                const SDL_Point &idx_tile_src = tower_relocating->get_idx_tile();
+                if (idx_tile_selected.x == idx_tile_src.x && idx_tile_selected.y == idx_tile_src.y)
+                    break;
+
+                if (can_place_tower(idx_tile_selected))
+                    TowerManager::instance()->relocate_tower(tower_relocating, idx_tile_selected);
+                else
+                    tile_reject_marker.show(idx_tile_selected);
+                break;
+            }
 
-                if (check_home(idx_tile_selected))
-                {
-                    upgrade_panel->set_idx_tile(idx_tile_selected);
-                    upgrade_panel->set_center_pos(pos_center);
-                    upgrade_panel->show();
-                }
-                else if (can_place_tower(idx_tile_selected))
-                {
-                    place_panel->set_idx_tile(idx_tile_selected);
-                    place_panel->set_center_pos(pos_center);
-                    place_panel->show();
-                }
+            get_selected_tile_center_pos(pos_center, idx_tile_selected);
+
+            if (check_home(idx_tile_selected))
+            {
+                upgrade_panel->set_idx_tile(idx_tile_selected);
+                upgrade_panel->set_center_pos(pos_center);
+                upgrade_panel->show();
             }
-            break;
+            else if (Tower *tower = TowerManager::instance()->find_tower(idx_tile_selected))
+            {
+                tower_panel->set_tower(tower->get_handle());
+                tower_panel->set_idx_tile(idx_tile_selected);
+                tower_panel->set_center_pos(pos_center);
+                tower_panel->show();
+            }
+            else if (can_place_tower(idx_tile_selected))
+            {
+                place_panel->set_idx_tile(idx_tile_selected);
+                place_panel->set_center_pos(pos_center);
+                place_panel->show();
+            }
+        }
+        break;
         default:
             break;
         }
 
         if (!instance->is_game_over)
         {
-            place_panel->on_input(event);
-            upgrade_panel->on_input(event);
+            place_panel->on_input(event_world);
+            upgrade_panel->on_input(event_world);
+            tower_panel->on_input(event_world);
             PlayerManager::instance()->on_input(event);
         }
     }
@@ -190,27 +401,31 @@ private:
         static bool is_game_over_last_tick = false;
         static ConfigManager *instance = ConfigManager::instance();
 
+        camera.on_update(delta);
+        debug_overlay.on_update(delta);
+        tile_reject_marker.on_update(delta);
+
+        AudioManager::instance()->set_listener_position(camera.get_center());
+        AudioManager::instance()->on_update(delta);
+
         if (!instance->is_game_over)
         {
-            status_bar.on_update(renderer);
-            place_panel->on_update(renderer);
-            upgrade_panel->on_update(renderer);
-            WaveManager::instance()->on_update(delta);
-            EnemyManager::instance()->on_update(delta);
-            CoinManager::instance()->on_update(delta);
-            BulletManager::instance()->on_update(delta);
-            TowerManager::instance()->on_update(delta);
-            PlayerManager::instance()->on_update(delta);
+            status_bar.on_update();
+            place_panel->on_update();
+            upgrade_panel->on_update();
+            tower_panel->on_update();
+            SimulationManager::instance()->on_update(delta);
 
             return;
         }
 
         if (!is_game_over_last_tick && instance->is_game_over)
         {
-            static const ResourcesManager::SoundPool &sound_pool = ResourcesManager::instance()->get_sound_pool();
-
             Mix_FadeOutMusic(1500);
-            Mix_PlayChannel(-1, sound_pool.find(instance->is_game_win ? ResID::Sound_Win : ResID::Sound_Loss)->second, 0);
+            AudioManager::instance()->play_sound(instance->is_game_win ? ResID::Sound_Win : ResID::Sound_Loss);
+
+            if (!instance->basic_template.stats_path.empty())
+                StatsManager::instance()->write_csv(instance->basic_template.stats_path);
         }
 
         is_game_over_last_tick = instance->is_game_over;
@@ -220,102 +435,174 @@ private:
             is_quit = true;
     }
 
-    void on_render()
+    // 订阅需要播放音效的游戏事件
+    void subscribe_audio_event()
+    {
+        static AudioManager *audio_manager = AudioManager::instance();
+        EventBus *event_bus = EventBus::instance();
+
+        // 由音效管理器统一分配声道，同一帧内多个敌人到达基地只播放一次
+        event_bus->subscribe<EnemyReachedHomeEvent>(
+            [](void *, const EnemyReachedHomeEvent &)
+            { audio_manager->play_sound(ResID::Sound_HomeHurt); });
+        event_bus->subscribe<BulletFiredEvent>(
+            [](void *, const BulletFiredEvent &event)
+            {
+                switch (event.tower_type)
+                {
+                case Archer:
+                    audio_manager->play_sound(rand() % 2 == 0 ? ResID::Sound_ArrowFire_1 : ResID::Sound_ArrowFire_2, event.position);
+                    break;
+                case Axeman:
+                    audio_manager->play_sound(ResID::Sound_AxeFire, event.position);
+                    break;
+                case Gunner:
+                    audio_manager->play_sound(ResID::Sound_ShellFire, event.position);
+                    break;
+                }
+            });
+        event_bus->subscribe<TowerPlacedEvent>(
+            [](void *, const TowerPlacedEvent &)
+            { audio_manager->play_sound(ResID::Sound_PlaceTower); });
+        event_bus->subscribe<TowerSoldEvent>(
+            [](void *, const TowerSoldEvent &)
+            { audio_manager->play_sound(ResID::Sound_PlaceTower); });
+        event_bus->subscribe<TowerRelocatedEvent>(
+            [](void *, const TowerRelocatedEvent &)
+            { audio_manager->play_sound(ResID::Sound_PlaceTower); });
+        event_bus->subscribe<TowerUpgradedEvent>(
+            [](void *, const TowerUpgradedEvent &)
+            { audio_manager->play_sound(ResID::Sound_TowerLevelUp); });
+        event_bus->subscribe<CoinPickedEvent>(
+            [](void *, const CoinPickedEvent &)
+            { audio_manager->play_sound(ResID::Sound_Coin); });
+    }
+
+    // 把本帧需要绘制的内容录制到快照（模拟线程）
+    void on_record(RenderSnapshot &snapshot)
     {
         static ConfigManager *instance = ConfigManager::instance();
-        static SDL_Rect &rect_dst = instance->rect_tile_map;
-        SDL_RenderCopy(renderer, tex_tile_map, nullptr, &rect_dst);
 
-        EnemyManager::instance()->on_render(renderer);
-        CoinManager::instance()->on_render(renderer);
-        BulletManager::instance()->on_render(renderer);
-        TowerManager::instance()->on_render(renderer);
-        PlayerManager::instance()->on_render(renderer);
+        // 世界层：坐标减去摄像机位置，渲染时再按摄像机缩放
+        snapshot.set_view(camera.get_zoom(), camera.get_view_rect());
+        snapshot.set_layer(RenderSnapshot::Layer::World);
+
+        EnemyManager::instance()->on_render(snapshot, camera);
+        CoinManager::instance()->on_render(snapshot, camera);
+        BulletManager::instance()->on_render(snapshot, camera);
+        TowerManager::instance()->on_render(snapshot, camera);
+        PlayerManager::instance()->on_render(snapshot, camera);
 
         if (!instance->is_game_over)
         {
-            place_panel->on_render(renderer);
-            upgrade_panel->on_render(renderer);
-            status_bar.on_render(renderer);
+            place_panel->on_render(snapshot, camera);
+            upgrade_panel->on_render(snapshot, camera);
+            tower_panel->on_render(snapshot, camera);
+            record_relocate_preview(snapshot);
+            tile_reject_marker.on_render(snapshot, camera);
+        }
 
-            return;
+        // 界面层：不受摄像机影响
+        snapshot.set_layer(RenderSnapshot::Layer::UI);
+
+        if (!instance->is_game_over)
+        {
+            status_bar.on_render(snapshot);
+        }
+        else
+        {
+            const ConfigManager::BasicTemplate &basic_template = instance->basic_template;
+            banner->set_center_position({(double)basic_template.window_width / 2, (double)basic_template.window_height / 2});
+            banner->on_render(snapshot);
+        }
+
+        debug_overlay.on_render(snapshot);
+    }
+
+    // 绘制快照（渲染线程）
+    void on_render(const RenderSnapshot &snapshot)
+    {
+        static const SDL_Rect &rect_tile_map = ConfigManager::instance()->rect_tile_map;
+
+        // 只重新烘焙发生变化的区块，只绘制窗口内可见的区块
+        {
+            std::lock_guard<std::mutex> lock(mutex_dirty_tile);
+            dirty_tile_list_render.swap(dirty_tile_list);
         }
+        for (const SDL_Point &idx_tile : dirty_tile_list_render)
+            tile_map_renderer.mark_dirty(idx_tile);
+        dirty_tile_list_render.clear();
+
+        // 世界层：按摄像机缩放
+        double zoom = snapshot.get_zoom();
+        SDL_RenderSetScale(renderer, (float)zoom, (float)zoom);
+
+        const SDL_Rect &rect_view = snapshot.get_view_rect();
+        const SDL_Rect rect_tile_map_view = {rect_tile_map.x - rect_view.x, rect_tile_map.y - rect_view.y, rect_tile_map.w, rect_tile_map.h};
+        tile_map_renderer.on_render(renderer, rect_tile_map_view, {0, 0, rect_view.w, rect_view.h});
+
+        snapshot.execute(renderer, text_cache, RenderSnapshot::Layer::World);
 
-        int width_screen, height_screen;
-        SDL_GetWindowSizeInPixels(window, &width_screen, &height_screen);
-        banner->set_center_position({(double)width_screen / 2, (double)height_screen / 2});
-        banner->on_render(renderer);
+        // 界面层：不受摄像机影响
+        SDL_RenderSetScale(renderer, 1, 1);
+
+        snapshot.execute(renderer, text_cache, RenderSnapshot::Layer::UI);
     }
 
-    bool generate_tile_map_texture()
+    bool init_tile_map_renderer()
     {
         const Map &map = ConfigManager::instance()->map;
-        const TileMap &tile_map = map.get_tile_map();
         SDL_Rect &rect_tile_map = ConfigManager::instance()->rect_tile_map;
-        SDL_Texture *tex_tile_set = ResourcesManager::instance()->get_texture_pool().find(ResID::Tex_Tileset)->second;
-
-        int width_tex_tile_set, height_tex_tile_set;
-        SDL_QueryTexture(tex_tile_set, nullptr, nullptr, &width_tex_tile_set, &height_tex_tile_set);
-        int num_tile_single_line = (int)std::ceil((double)width_tex_tile_set / SIZE_TILE);
-
-        int width_tex_tile_map, height_tex_tile_map;
-        width_tex_tile_map = (int)map.get_width() * SIZE_TILE;
-        height_tex_tile_map = (int)map.get_height() * SIZE_TILE;
-        tex_tile_map = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888,
-                                         SDL_TEXTUREACCESS_TARGET, width_tex_tile_map, height_tex_tile_map);
-        if (!tex_tile_map)
-            return false;
+        const ResourcesManager::TexturePool &texture_pool = ResourcesManager::instance()->get_texture_pool();
 
-        ConfigManager *config = ConfigManager::instance();
-        rect_tile_map.x = (config->basic_template.window_width - width_tex_tile_map) / 2;
-        rect_tile_map.y = (config->basic_template.window_height - height_tex_tile_map) / 2;
-        rect_tile_map.w = width_tex_tile_map;
-        rect_tile_map.h = height_tex_tile_map;
+        int width_tile_map = (int)map.get_width() * SIZE_TILE;
+        int height_tile_map = (int)map.get_height() * SIZE_TILE;
 
-        SDL_SetTextureBlendMode(tex_tile_map, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderTarget(renderer, tex_tile_map);
+        // 地图左上角即世界坐标原点，居中显示由摄像机负责
+        rect_tile_map.x = 0;
+        rect_tile_map.y = 0;
+        rect_tile_map.w = width_tile_map;
+        rect_tile_map.h = height_tile_map;
 
-        for (int y = 0; y < map.get_height(); y++)
-        {
-            for (int x = 0; x < map.get_width(); x++)
-            {
-                SDL_Rect rect_src;
-                const Tile &tile = tile_map[y][x];
-
-                const SDL_Rect &rect_dst =
-                    {
-                        x * SIZE_TILE, y * SIZE_TILE,
-                        SIZE_TILE, SIZE_TILE};
-
-                rect_src =
-                    {
-                        (tile.terrian % num_tile_single_line) * SIZE_TILE,
-                        (tile.terrian / num_tile_single_line) * SIZE_TILE,
-                        SIZE_TILE, SIZE_TILE};
-                SDL_RenderCopy(renderer, tex_tile_set, &rect_src, &rect_dst);
-
-                if (tile.decoration >= 0)
-                {
-                    rect_src =
-                        {
-                            (tile.decoration % num_tile_single_line) * SIZE_TILE,
-                            (tile.decoration / num_tile_single_line) * SIZE_TILE,
-                            SIZE_TILE, SIZE_TILE};
-                    SDL_RenderCopy(renderer, tex_tile_set, &rect_src, &rect_dst);
-                }
-            }
-        }
+        return tile_map_renderer.init(map, texture_pool.find(ResID::Tex_Tileset)->second,
+                                      texture_pool.find(ResID::Tex_Home)->second);
+    }
 
-        const SDL_Point &idx_home = map.get_idx_home();
-        const SDL_Rect rect_dst =
-            {
-                idx_home.x * SIZE_TILE, idx_home.y * SIZE_TILE,
-                SIZE_TILE, SIZE_TILE};
-        SDL_RenderCopy(renderer, ResourcesManager::instance()->get_texture_pool().find(ResID::Tex_Home)->second, nullptr, &rect_dst);
+    // 迁移防御塔时标出原瓦片，并在鼠标所在的瓦片上预览目标位置和攻击范围，无法放置时显示为红色
+    void record_relocate_preview(RenderSnapshot &snapshot)
+    {
+        static const SDL_Color color_src = {255, 215, 0, 220};
+        static const SDL_Color color_dst_content = {60, 200, 90, 90};
+        static const SDL_Color color_dst_frame = {60, 200, 90, 220};
+        static const SDL_Color color_reject_content = {220, 40, 40, 90};
+        static const SDL_Color color_reject_frame = {220, 40, 40, 220};
+        static const SDL_Color color_region_frame = {30, 80, 162, 175};
+
+        const Tower *tower = TowerManager::instance()->get_tower(tower_panel->get_tower_relocating());
+        if (!tower)
+            return;
 
-        SDL_SetRenderTarget(renderer, nullptr);
+        SDL_Point pos_tile;
+        get_selected_tile_center_pos(pos_tile, tower->get_idx_tile());
+        Vector2 pos_view = camera.world_to_view({(double)(pos_tile.x - SIZE_TILE / 2), (double)(pos_tile.y - SIZE_TILE / 2)});
+        snapshot.draw_rect({(int)pos_view.x, (int)pos_view.y, SIZE_TILE, SIZE_TILE}, color_src);
 
-        return true;
+        SDL_Point idx_tile_hovered;
+        if (!get_cursor_idx_tile(idx_tile_hovered, pos_cursor_world.x, pos_cursor_world.y))
+            return;
+
+        const bool is_valid = can_place_tower(idx_tile_hovered);
+        get_selected_tile_center_pos(pos_tile, idx_tile_hovered);
+        pos_view = camera.world_to_view({(double)(pos_tile.x - SIZE_TILE / 2), (double)(pos_tile.y - SIZE_TILE / 2)});
+        const SDL_Rect rect_dst = {(int)pos_view.x, (int)pos_view.y, SIZE_TILE, SIZE_TILE};
+        snapshot.fill_rect(rect_dst, is_valid ? color_dst_content : color_reject_content);
+        snapshot.draw_rect(rect_dst, is_valid ? color_dst_frame : color_reject_frame);
+
+        if (is_valid)
+        {
+            const SDL_Point center_view = {rect_dst.x + SIZE_TILE / 2, rect_dst.y + SIZE_TILE / 2};
+            snapshot.draw_circle(center_view, (int)tower->get_stats().view_range_pixel, color_region_frame);
+        }
     }
 
     bool check_home(const SDL_Point &idx_tile_selected)
@@ -326,16 +613,16 @@ private:
         return (idx_home.x == idx_tile_selected.x && idx_home.y == idx_tile_selected.y);
     }
 
-    bool get_cursor_idx_tile(SDL_Point &idx_tile_selected, int screen_x, int screen_y) const
+    bool get_cursor_idx_tile(SDL_Point &idx_tile_selected, int world_x, int world_y) const
     {
         static const Map &map = ConfigManager::instance()->map;
         static const SDL_Rect &rect_tile_map = ConfigManager::instance()->rect_tile_map;
 
-        if (screen_x < rect_tile_map.x || screen_x > rect_tile_map.x + rect_tile_map.w || screen_y < rect_tile_map.y || screen_y > rect_tile_map.x + rect_tile_map.h)
+        if (world_x < rect_tile_map.x || world_x > rect_tile_map.x + rect_tile_map.w || world_y < rect_tile_map.y || world_y > rect_tile_map.y + rect_tile_map.h)
             return false;
 
-        idx_tile_selected.x = std::min((screen_x - rect_tile_map.x) / SIZE_TILE, (int)map.get_width() - 1);
-        idx_tile_selected.y = std::min((screen_y - rect_tile_map.y) / SIZE_TILE, (int)map.get_height() - 1);
+        idx_tile_selected.x = std::min((world_x - rect_tile_map.x) / SIZE_TILE, (int)map.get_width() - 1);
+        idx_tile_selected.y = std::min((world_y - rect_tile_map.y) / SIZE_TILE, (int)map.get_height() - 1);
 
         return true;
     }
@@ -343,9 +630,13 @@ private:
     bool can_place_tower(const SDL_Point &idx_tile_selected) const
     {
         static const Map &map = ConfigManager::instance()->map;
-        const Tile &tile = map.get_tile_map()[idx_tile_selected.y][idx_tile_selected.x];
+        const Tile &tile = map.get_tile_map().at(idx_tile_selected);
+
+        // 自由寻路模式下道路也可以放置防御塔，生成点和终点除外
+        if (map.is_free_pathing())
+            return (tile.decoration < 0 && tile.special_flag < 0 && !tile.has_tower());
 
-        return (tile.decoration < 0 && tile.direction == Tile::Direction::None && !tile.has_tower);
+        return (tile.decoration < 0 && tile.get_direction() == Tile::Direction::None && !tile.has_tower());
     }
 
     void get_selected_tile_center_pos(SDL_Point &pos, const SDL_Point &idx_tile_selected) const
@@ -4,7 +4,6 @@
 // 包含必要的头文件
 #include "manager.h"           // 基础管理器模板
 #include "config_manager.h"    // 配置管理器，用于读取初始生命值
-#include "resources_manager.h" // 资源管理器，用于播放音效
 
 // HomeManager 类：负责管理玩家基地的生命值
 // 该类继承自 Manager 模板类，实现了单例模式
@@ -31,14 +30,6 @@ public:
           // 确保生命值不会小于 0
           if (num_hp < 0)
                num_hp = 0;
-
-          // 获取音效池
-          static const ResourcesManager::SoundPool &sound_pool = ResourcesManager::instance()->get_sound_pool();
-
-          // 播放基地受伤音效
-          // Mix_PlayChannel 是 SDL_mixer 库的函数，用于播放音效
-          // -1 表示自动选择可用声道，0 表示不循环播放
-          Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_HomeHurt)->second, 0);
      }
 
 protected:
@@ -6,9 +6,13 @@
 #include "game_map/vector2.h"
 #include "manager.h"
 #include "animation.h"
+#include "camera.h"
 #include "coin_manager.h"
 #include "enemy_manager.h"
 #include "resources_manager.h"
+#include "audio_manager.h"
+#include "command_buffer.h"
+#include "event_bus.h"
 
 #include <SDL.h>
 
@@ -72,6 +76,8 @@ public:
 
      void on_update(double delta)
      {
+          static CommandBuffer *command_buffer = CommandBuffer::instance();
+
           timer_auto_increase_mp.on_update(delta);
           timer_release_flash_cd.on_update(delta);
 
@@ -146,15 +152,20 @@ public:
                anim_effect_flash_current->on_update(delta);
 
                EnemyManager::EnemyList &enemy_list = EnemyManager::instance()->get_enemy_list();
-               for (Enemy *enemy : enemy_list)
+               for (size_t i = 0; i < enemy_list.size(); i++)
                {
+                    Enemy *enemy = enemy_list[i];
                     if (enemy->can_remove())
                          continue;
 
                     const Vector2 &position = enemy->get_position();
                     if (position.x >= rect_hitbox_flash.x && position.x <= rect_hitbox_flash.x + rect_hitbox_flash.w && position.y >= rect_hitbox_flash.y && position.y <= rect_hitbox_flash.y + rect_hitbox_flash.h)
                     {
-                         enemy->decrease_hp(ConfigManager::instance()->player_template.normal_attack_damage * delta);
+                         CommandBuffer::ApplyDamage command;
+                         command.enemy_target = enemy_list.get_handle(i);
+                         command.damage = ConfigManager::instance()->player_template.normal_attack_damage * delta;
+                         command.can_drop_coin = false;
+                         command_buffer->apply_damage(command);
                     }
                }
           }
@@ -164,8 +175,9 @@ public:
                anim_effect_impact_current->on_update(delta);
 
                EnemyManager::EnemyList &enemy_list = EnemyManager::instance()->get_enemy_list();
-               for (Enemy *enemy : enemy_list)
+               for (size_t i = 0; i < enemy_list.size(); i++)
                {
+                    Enemy *enemy = enemy_list[i];
                     if (enemy->can_remove())
                          continue;
 
@@ -173,15 +185,17 @@ public:
                     const Vector2 &position = enemy->get_position();
                     if (position.x >= rect_hitbox_impact.x && position.x <= rect_hitbox_impact.x + rect_hitbox_impact.w && position.y >= rect_hitbox_impact.y && position.y <= rect_hitbox_impact.y + rect_hitbox_impact.h)
                     {
-                         enemy->decrease_hp(ConfigManager::instance()->player_template.skill_damage * delta);
-                         enemy->slow_down();
+                         CommandBuffer::ApplyDamage command;
+                         command.enemy_target = enemy_list.get_handle(i);
+                         command.damage = ConfigManager::instance()->player_template.skill_damage * delta;
+                         command.can_drop_coin = false;
+                         command.is_slow_down = true;
+                         command_buffer->apply_damage(command);
                     }
                }
           }
 
           CoinManager::CoinPropList &coin_prop_list = CoinManager::instance()->get_coin_prop_list();
-          static const ResourcesManager::SoundPool &sound_pool = ResourcesManager::instance()->get_sound_pool();
-
           for (CoinProp *coin_prop : coin_prop_list)
           {
                if (coin_prop->can_remove())
@@ -191,33 +205,38 @@ public:
                if (pos_coin_prop.x >= position.x - size.x / 2 && pos_coin_prop.x <= position.x + size.x / 2 && pos_coin_prop.y >= position.y - size.y / 2 && pos_coin_prop.y <= position.y + size.y / 2)
                {
                     coin_prop->make_invalid();
-                    CoinManager::instance()->increase_coin(10);
+                    CoinManager::instance()->increase_coin(value_coin_prop);
 
-                    Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_Coin)->second, 0);
+                    EventBus::instance()->publish(CoinPickedEvent{pos_coin_prop, value_coin_prop});
                }
           }
      }
 
-     void on_render(SDL_Renderer *renderer)
+     void on_render(RenderSnapshot &snapshot, const Camera &camera)
      {
           static SDL_Point point;
 
-          point.x = (int)(position.x - size.x / 2);
-          point.y = (int)(position.y - size.y / 2);
-          anim_current->on_render(renderer, point);
+          const Vector2 &pos_camera = camera.get_position();
 
-          if (is_releasing_flash)
+          if (camera.is_visible(position, size))
           {
-               point.x = rect_hitbox_flash.x;
-               point.y = rect_hitbox_flash.y;
-               anim_effect_flash_current->on_render(renderer, point);
+               point.x = (int)(position.x - size.x / 2 - pos_camera.x);
+               point.y = (int)(position.y - size.y / 2 - pos_camera.y);
+               anim_current->on_render(snapshot, point);
           }
 
-          if (is_releasing_impact)
+          if (is_releasing_flash && is_rect_visible(rect_hitbox_flash, camera))
+          {
+               point.x = (int)(rect_hitbox_flash.x - pos_camera.x);
+               point.y = (int)(rect_hitbox_flash.y - pos_camera.y);
+               anim_effect_flash_current->on_render(snapshot, point);
+          }
+
+          if (is_releasing_impact && is_rect_visible(rect_hitbox_impact, camera))
           {
-               point.x = rect_hitbox_impact.x;
-               point.y = rect_hitbox_impact.y;
-               anim_effect_impact_current->on_render(renderer, point);
+               point.x = (int)(rect_hitbox_impact.x - pos_camera.x);
+               point.y = (int)(rect_hitbox_impact.y - pos_camera.y);
+               anim_effect_impact_current->on_render(snapshot, point);
           }
      }
 
@@ -342,6 +361,8 @@ private:
 
      double speed = 0;
 
+     const double value_coin_prop = 10; // 每个金币道具的金币数量
+
      bool can_release_flash = true;
      bool is_releasing_flash = false;
      bool is_releasing_impact = false;
@@ -379,6 +400,11 @@ private:
      Facing facing = Facing::Left;
 
 private:
+     bool is_rect_visible(const SDL_Rect &rect, const Camera &camera) const
+     {
+          return camera.is_visible({rect.x + rect.w / 2.0, rect.y + rect.h / 2.0}, {(double)rect.w, (double)rect.h});
+     }
+
      void on_release_flash()
      {
           if (!can_release_flash || is_releasing_flash)
@@ -416,9 +442,7 @@ private:
           anim_effect_flash_current->reset();
           timer_release_flash_cd.restart();
 
-          static const ResourcesManager::SoundPool &sound_pool = ResourcesManager::instance()->get_sound_pool();
-
-          Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_Flash)->second, 0);
+          AudioManager::instance()->play_sound(ResID::Sound_Flash);
      }
 
      void on_release_impact()
@@ -458,9 +482,7 @@ private:
           is_releasing_impact = true;
           anim_effect_impact_current->reset();
 
-          static const ResourcesManager::SoundPool &sound_pool = ResourcesManager::instance()->get_sound_pool();
-
-          Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_Impact)->second, 0);
+          AudioManager::instance()->play_sound(ResID::Sound_Impact);
      }
 };
 
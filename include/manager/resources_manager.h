@@ -102,7 +102,9 @@ enum class ResID
      Music_BGM, // 背景音乐
 
      // 字体
-     Font_Main // 主字体
+     Font_Main, // 主字体
+
+     Count // 资源ID数量，必须位于最后
 };
 
 // 资源管理器：负责加载和管理游戏资源
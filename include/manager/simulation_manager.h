@@ -0,0 +1,91 @@
+#ifndef _SIMULATION_MANAGER_H_
+#define _SIMULATION_MANAGER_H_
+
+#include "manager.h"
+#include "wave_manager.h"
+#include "enemy_manager.h"
+#include "coin_manager.h"
+#include "bullet_manager.h"
+#include "tower_manager.h"
+#include "player_manager.h"
+#include "stats_manager.h"
+#include "audio_manager.h"
+#include "command_buffer.h"
+#include "event_bus.h"
+
+// 模拟管理器：按固定顺序推进一帧游戏世界
+// 只包含实体更新、同步点结算和事件分发，不涉及界面、摄像机和渲染，
+// 游戏主循环和无窗口的性能测试（td_perf）共用同一段逻辑，测到的就是游戏实际执行的代码
+class SimulationManager : public Manager<SimulationManager>
+{
+     friend class Manager<SimulationManager>;
+
+public:
+     // 推进一帧模拟
+     // @param delta: 时间增量（秒）
+     void on_update(double delta)
+     {
+          WaveManager::instance()->on_update(delta);
+          EnemyManager::instance()->on_update(delta);
+          CoinManager::instance()->on_update(delta);
+          BulletManager::instance()->on_update(delta, EnemyManager::instance()->get_enemy_list());
+          TowerManager::instance()->on_update(delta);
+          PlayerManager::instance()->on_update(delta);
+          StatsManager::instance()->on_update(delta);
+
+          // 同步点：统一结算本帧的跨管理器副作用，之后再移除无效实体
+          flush_command_buffer();
+
+          EnemyManager::instance()->remove_invalid_enemy();
+          BulletManager::instance()->remove_invalid_bullet();
+          CoinManager::instance()->remove_invalid_coin_prop();
+
+          // 把本帧发布的游戏事件分发给订阅者
+          EventBus::instance()->dispatch();
+     }
+
+protected:
+     SimulationManager() = default;
+     ~SimulationManager() = default;
+
+private:
+     // 按固定顺序分批执行指令缓冲中的指令：治疗、伤害（可能产生金币掉落，伤害和击杀记到来源防御塔）、金币、子弹、音效
+     void flush_command_buffer()
+     {
+          static CommandBuffer *command_buffer = CommandBuffer::instance();
+          static EnemyManager *enemy_manager = EnemyManager::instance();
+          static CoinManager *coin_manager = CoinManager::instance();
+          static BulletManager *bullet_manager = BulletManager::instance();
+          static TowerManager *tower_manager = TowerManager::instance();
+          static AudioManager *audio_manager = AudioManager::instance();
+
+          command_buffer->for_each<CommandBuffer::Heal>(
+              [](const CommandBuffer::Heal &command)
+              { enemy_manager->apply_heal(command); });
+          command_buffer->for_each<CommandBuffer::ApplyDamage>(
+              [](const CommandBuffer::ApplyDamage &command)
+              {
+                   EnemyManager::DamageResult result = enemy_manager->apply_damage(command);
+                   if (!command.tower_source.is_null())
+                        tower_manager->record_damage(command.tower_source, result.damage, result.num_kill);
+              });
+          command_buffer->for_each<CommandBuffer::SpawnCoin>(
+              [](const CommandBuffer::SpawnCoin &command)
+              { coin_manager->apply_spawn_coin(command); });
+          command_buffer->for_each<CommandBuffer::SpawnBullet>(
+              [](const CommandBuffer::SpawnBullet &command)
+              { bullet_manager->apply_spawn_bullet(command); });
+          command_buffer->for_each<CommandBuffer::PlaySound>(
+              [](const CommandBuffer::PlaySound &command)
+              {
+                   if (command.has_position)
+                        audio_manager->play_sound(command.id, command.position);
+                   else
+                        audio_manager->play_sound(command.id);
+              });
+
+          command_buffer->clear();
+     }
+};
+
+#endif // !_SIMULATION_MANAGER_H_
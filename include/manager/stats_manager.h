@@ -0,0 +1,222 @@
+#ifndef _STATS_MANAGER_H_
+#define _STATS_MANAGER_H_
+
+#include "manager.h"
+#include "coin_manager.h"
+#include "event_bus.h"
+#include "histogram.h"
+#include "enemy/enemy_type.h"
+#include "tower/tower_type.h"
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <iostream>
+
+// 统计管理器：订阅游戏事件，累计一局游戏的数据，关卡结束时写出CSV
+// 统计内容包括：
+// 1. 每种防御塔的伤害、击杀、开火次数、放置数量和DPS
+// 2. 每种敌人的击杀数、到达终点数和击杀用时（从生成到被击杀）的分布
+// 3. 每个波次基地受到的伤害
+// 4. 获得与花费的金币
+// 5. 模拟帧耗时的分布
+// 所有分布都是固定桶数的直方图，记录时不分配内存；不依赖渲染，可用于无窗口的批量运行
+// 输出为"section,key,field,value"四列的长表，便于直接导入表格或数据分析工具
+class StatsManager : public Manager<StatsManager>
+{
+     friend class Manager<StatsManager>;
+
+public:
+     // 开始记录一局游戏：清空数据，首次调用时订阅事件
+     // @param num_wave: 波次数量，用于分配每波的统计
+     void start(size_t num_wave)
+     {
+          if (!is_subscribed)
+          {
+               subscribe_event();
+               is_subscribed = true;
+          }
+
+          time_session = 0;
+          idx_wave = 0;
+          for (TowerTypeStats &stats : tower_stats_list)
+               stats = TowerTypeStats();
+          for (EnemyTypeStats &stats : enemy_stats_list)
+               stats.reset();
+          home_damage_list.assign(num_wave, 0);
+          frame_time_ms.reset();
+     }
+
+     // 累计游戏时间
+     // @param delta: 时间增量（秒）
+     void on_update(double delta)
+     {
+          time_session += delta;
+     }
+
+     // 记录一帧模拟的耗时
+     // @param seconds: 耗时（秒）
+     void record_frame_time(double seconds)
+     {
+          frame_time_ms.add(seconds * 1000);
+     }
+
+     // 写出CSV文件
+     // @param path: 文件路径
+     // @return: 写出成功时返回true
+     bool write_csv(const std::string &path) const
+     {
+          std::ofstream file(path);
+          if (!file.good())
+          {
+               std::cerr << "[ERROR] Failed to write stats: " << path << std::endl;
+               return false;
+          }
+
+          file << "section,key,field,value\n";
+          file << "session,duration,seconds," << time_session << "\n";
+
+          for (int i = 0; i < num_tower_type; i++)
+          {
+               const TowerTypeStats &stats = tower_stats_list[i];
+               const char *name = tower_type_name_list[i];
+               file << "tower," << name << ",placed," << stats.num_placed << "\n";
+               file << "tower," << name << ",shots," << stats.num_fired << "\n";
+               file << "tower," << name << ",kills," << stats.num_kill << "\n";
+               file << "tower," << name << ",damage," << stats.damage << "\n";
+               file << "tower," << name << ",dps," << (time_session > 0 ? stats.damage / time_session : 0) << "\n";
+          }
+
+          for (int i = 0; i < num_enemy_type; i++)
+          {
+               const EnemyTypeStats &stats = enemy_stats_list[i];
+               const char *name = enemy_type_name_list[i];
+               file << "enemy," << name << ",kills," << stats.time_to_kill.get_count() << "\n";
+               file << "enemy," << name << ",reached_home," << stats.num_reached_home << "\n";
+               file << "enemy," << name << ",ttk_mean," << stats.time_to_kill.get_mean() << "\n";
+               file << "enemy," << name << ",ttk_p50," << stats.time_to_kill.get_percentile(0.5) << "\n";
+               file << "enemy," << name << ",ttk_p95," << stats.time_to_kill.get_percentile(0.95) << "\n";
+               file << "enemy," << name << ",ttk_max," << stats.time_to_kill.get_max() << "\n";
+          }
+
+          for (size_t i = 0; i < home_damage_list.size(); i++)
+               file << "wave," << i << ",home_damage," << home_damage_list[i] << "\n";
+
+          file << "coin,total,earned," << CoinManager::instance()->get_coin_earned() << "\n";
+          file << "coin,total,spent," << CoinManager::instance()->get_coin_spent() << "\n";
+
+          file << "frame_time,total,count," << frame_time_ms.get_count() << "\n";
+          file << "frame_time,total,mean_ms," << frame_time_ms.get_mean() << "\n";
+          file << "frame_time,total,p50_ms," << frame_time_ms.get_percentile(0.5) << "\n";
+          file << "frame_time,total,p95_ms," << frame_time_ms.get_percentile(0.95) << "\n";
+          file << "frame_time,total,p99_ms," << frame_time_ms.get_percentile(0.99) << "\n";
+          file << "frame_time,total,max_ms," << frame_time_ms.get_max() << "\n";
+
+          // 直方图只写出非空的桶，两种直方图布局相同：key为统计对象，field为le_加桶的上界，value为计数
+          for (size_t i = 0; i < frame_time_ms.get_num_bucket(); i++)
+          {
+               if (frame_time_ms.get_bucket(i) > 0)
+                    file << "frame_time_hist,total,le_" << frame_time_ms.get_bucket_upper(i) << "," << frame_time_ms.get_bucket(i) << "\n";
+          }
+
+          for (int i = 0; i < num_enemy_type; i++)
+          {
+               const Histogram<num_bucket_ttk> &hist = enemy_stats_list[i].time_to_kill;
+               for (size_t j = 0; j < hist.get_num_bucket(); j++)
+               {
+                    if (hist.get_bucket(j) > 0)
+                         file << "ttk_hist," << enemy_type_name_list[i] << ",le_" << hist.get_bucket_upper(j) << "," << hist.get_bucket(j) << "\n";
+               }
+          }
+
+          std::cout << "[INFO] Stats written to " << path << std::endl;
+          return file.good();
+     }
+
+protected:
+     StatsManager() = default;
+     ~StatsManager() = default;
+
+private:
+     static constexpr int num_tower_type = 3;
+     static constexpr int num_enemy_type = 5;
+     static constexpr size_t num_bucket_ttk = 120;        // 击杀用时直方图：0-120秒，每桶1秒
+     static constexpr size_t num_bucket_frame_time = 200; // 帧耗时直方图：0-100毫秒，每桶0.5毫秒
+
+     static constexpr const char *tower_type_name_list[num_tower_type] = {"Archer", "Axeman", "Gunner"};
+     static constexpr const char *enemy_type_name_list[num_enemy_type] = {"Slim", "KingSlim", "Skeleton", "Goblin", "GoblinPriest"};
+
+     // 单种防御塔的统计
+     struct TowerTypeStats
+     {
+          int num_placed = 0; // 放置数量
+          int num_fired = 0;  // 开火次数
+          int num_kill = 0;   // 击杀数
+          double damage = 0;  // 造成的伤害
+     };
+
+     // 单种敌人的统计
+     struct EnemyTypeStats
+     {
+          int num_reached_home = 0;                                          // 到达终点的数量
+          Histogram<num_bucket_ttk> time_to_kill{0, (double)num_bucket_ttk}; // 击杀用时（秒）
+
+          void reset()
+          {
+               num_reached_home = 0;
+               time_to_kill.reset();
+          }
+     };
+
+private:
+     bool is_subscribed = false; // 是否已订阅事件
+     double time_session = 0;    // 本局经过的游戏时间（秒）
+     int idx_wave = 0;           // 当前波次索引
+
+     TowerTypeStats tower_stats_list[num_tower_type];        // 每种防御塔的统计
+     EnemyTypeStats enemy_stats_list[num_enemy_type];        // 每种敌人的统计
+     std::vector<double> home_damage_list;                   // 每个波次基地受到的伤害
+     Histogram<num_bucket_frame_time> frame_time_ms{0, 100}; // 模拟帧耗时（毫秒）
+
+private:
+     void subscribe_event()
+     {
+          EventBus *event_bus = EventBus::instance();
+
+          event_bus->subscribe<TowerPlacedEvent>(
+              [](void *context, const TowerPlacedEvent &event)
+              { ((StatsManager *)context)->tower_stats_list[event.type].num_placed++; },
+              this);
+          event_bus->subscribe<BulletFiredEvent>(
+              [](void *context, const BulletFiredEvent &event)
+              { ((StatsManager *)context)->tower_stats_list[event.tower_type].num_fired++; },
+              this);
+          event_bus->subscribe<TowerDamageEvent>(
+              [](void *context, const TowerDamageEvent &event)
+              {
+                   TowerTypeStats &stats = ((StatsManager *)context)->tower_stats_list[event.tower_type];
+                   stats.damage += event.damage;
+                   stats.num_kill += event.num_kill;
+              },
+              this);
+          event_bus->subscribe<EnemyKilledEvent>(
+              [](void *context, const EnemyKilledEvent &event)
+              { ((StatsManager *)context)->enemy_stats_list[(int)event.type].time_to_kill.add(event.time_alive); },
+              this);
+          event_bus->subscribe<EnemyReachedHomeEvent>(
+              [](void *context, const EnemyReachedHomeEvent &event)
+              {
+                   StatsManager *self = (StatsManager *)context;
+                   self->enemy_stats_list[(int)event.type].num_reached_home++;
+                   if (self->idx_wave >= 0 && self->idx_wave < (int)self->home_damage_list.size())
+                        self->home_damage_list[self->idx_wave] += event.damage;
+              },
+              this);
+          event_bus->subscribe<WaveStartedEvent>(
+              [](void *context, const WaveStartedEvent &event)
+              { ((StatsManager *)context)->idx_wave = event.idx_wave; },
+              this);
+     }
+};
+
+#endif // !_STATS_MANAGER_H_
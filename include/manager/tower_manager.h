@@ -8,12 +8,17 @@
 
 #include "tower/tower.h"
 #include "tower/tower_type.h"
+#include "tower/tower_stats.h"
 #include "manager.h"
 #include "tower/archer_tower.h"
 #include "tower/axeman_tower.h"
 #include "tower/gunner_tower.h"
 #include "manager/config_manager.h"
 #include "manager/resources_manager.h"
+#include "manager/coin_manager.h"
+#include "job_system.h"
+#include "event_bus.h"
+#include "slot_map.h"
 
 #include <vector>
 
@@ -29,21 +34,34 @@ public:
      /**
       * @brief 更新所有防御塔的状态
       * @param delta 时间增量
+      *
+      * 计时器、动画和索敌只读取敌人列表、只修改塔自身，并行执行；
+      * 开火会生成子弹、播放音效并使用随机数，按塔的顺序串行执行以保证结果可复现
       */
      void on_update(double delta)
      {
+          static JobSystem *job_system = JobSystem::instance();
+
+          job_system->parallel_for(tower_list.size(), grain_update,
+                                   [&](size_t begin, size_t end)
+                                   {
+                                        for (size_t i = begin; i < end; i++)
+                                             tower_list[i]->on_update(delta);
+                                   });
+
           for (Tower *tower : tower_list)
-               tower->on_update(delta);
+               tower->on_fire();
      }
 
      /**
       * @brief 渲染所有防御塔
-      * @param renderer SDL渲染器指针
+      * @param snapshot 渲染快照
+      * @param camera 摄像机，视图外的防御塔不会绘制
       */
-     void on_render(SDL_Renderer *renderer)
+     void on_render(RenderSnapshot &snapshot, const Camera &camera)
      {
           for (Tower *tower : tower_list)
-               tower->on_render(renderer);
+               tower->on_render(snapshot, camera);
      }
 
      /**
@@ -53,22 +71,7 @@ public:
       */
      double get_place_cost(TowerType type)
      {
-          static ConfigManager *instance = ConfigManager::instance();
-
-          switch (type)
-          {
-          case Archer:
-               return instance->archer_template.cost[instance->level_archer];
-               break;
-          case Axeman:
-               return instance->axeman_template.cost[instance->level_axeman];
-               break;
-          case Gunner:
-               return instance->gunner_template.cost[instance->level_gunner];
-               break;
-          }
-
-          return 0;
+          return stats_cache.get_global(type).cost;
      }
 
      /**
@@ -78,22 +81,7 @@ public:
       */
      double get_upgrade_cost(TowerType type)
      {
-          static ConfigManager *instance = ConfigManager::instance();
-
-          switch (type)
-          {
-          case Archer:
-               return instance->level_archer == 9 ? -1 : instance->archer_template.upgrade_cost[instance->level_archer];
-               break;
-          case Axeman:
-               return instance->level_axeman == 9 ? -1 : instance->axeman_template.upgrade_cost[instance->level_axeman];
-               break;
-          case Gunner:
-               return instance->level_gunner == 9 ? -1 : instance->gunner_template.upgrade_cost[instance->level_gunner];
-               break;
-          }
-
-          return 0;
+          return stats_cache.get_global(type).upgrade_cost;
      }
 
      /**
@@ -103,22 +91,7 @@ public:
       */
      double get_damage_range(TowerType type)
      {
-          static ConfigManager *instance = ConfigManager::instance();
-
-          switch (type)
-          {
-          case Archer:
-               return instance->archer_template.view_range[instance->level_archer];
-               break;
-          case Axeman:
-               return instance->axeman_template.view_range[instance->level_axeman];
-               break;
-          case Gunner:
-               return instance->gunner_template.view_range[instance->level_gunner];
-               break;
-          }
-
-          return 0;
+          return stats_cache.get_global(type).view_range;
      }
 
      /**
@@ -146,19 +119,16 @@ public:
                break;
           }
 
-          static Vector2 position;
-          static const SDL_Rect &rect = ConfigManager::instance()->rect_tile_map;
-
-          position.x = rect.x + idx.x * SIZE_TILE + SIZE_TILE / 2;
-          position.y = rect.y + idx.y * SIZE_TILE + SIZE_TILE / 2;
-          tower->set_position(position);
-          tower_list.push_back(tower);
+          tower->set_position(get_tile_center(idx));
+          tower->set_stats(&stats_cache.get_global(type), true);
+          tower->add_coin_spent(get_place_cost(type));
+          TowerHandle handle = tower_list.insert(tower);
+          tower->set_registry(handle, idx);
+          tower_grid[get_idx_grid(idx)] = handle;
 
           ConfigManager::instance()->map.place_tower(idx);
 
-          static const ResourcesManager::SoundPool &sound_pool = ResourcesManager::instance()->get_sound_pool();
-
-          Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_PlaceTower)->second, 0);
+          EventBus::instance()->publish(TowerPlacedEvent{type, idx, tower->get_coin_spent()});
      }
 
      /**
@@ -181,18 +151,225 @@ public:
                instance->level_gunner = instance->level_gunner >= 9 ? 9 : instance->level_gunner + 1;
                break;
           }
+          stats_cache.refresh_global(type);
+
+          // 单独升级过的塔等级不高于新的全局等级时重新跟随全局等级，避免全局升级后反而落后
+          int level_global = TowerStatsCache::get_global_level(type);
+          for (Tower *tower : tower_list)
+          {
+               if (tower->get_tower_type() == type && !tower->is_following_global_level() && tower->get_level() <= level_global)
+                    set_tower_level(tower, -1);
+          }
+
+          EventBus::instance()->publish(TowerUpgradedEvent{type, {-1, -1}, level_global});
+     }
+
+     /**
+      * @brief 单独升级某座防御塔，之后该塔不再跟随全局等级
+      * @param tower 防御塔
+      */
+     void upgrade_tower(Tower *tower)
+     {
+          double cost = get_upgrade_cost(tower);
+          if (cost < 0)
+               return;
+
+          tower->add_coin_spent(cost);
+          set_tower_level(tower, tower->get_level() + 1);
+
+          EventBus::instance()->publish(TowerUpgradedEvent{tower->get_tower_type(), tower->get_idx_tile(), tower->get_level()});
+     }
+
+     /**
+      * @brief 获取出售某座防御塔返还的金币
+      * @param tower 防御塔
+      */
+     double get_sell_refund(const Tower *tower) const
+     {
+          return tower->get_coin_spent() * tower->get_stats().refund_ratio;
+     }
+
+     /**
+      * @brief 出售防御塔：返还金币、释放瓦片并注销，O(1)
+      * @param tower 防御塔，调用后失效；不能在遍历防御塔列表时调用
+      *
+      * 子弹和伤害指令通过句柄引用防御塔，注销后句柄自动失效，不需要额外清理
+      */
+     void sell_tower(Tower *tower)
+     {
+          const SDL_Point idx = tower->get_idx_tile();
+          const TowerType type = tower->get_tower_type();
+          const double refund = get_sell_refund(tower);
+
+          CoinManager::instance()->increase_coin(refund);
+
+          tower_grid[get_idx_grid(idx)] = TowerHandle();
+          tower_list.remove(tower->get_handle());
+          delete tower;
+
+          ConfigManager::instance()->map.remove_tower(idx);
+
+          // 音效等由事件订阅者处理
+          EventBus::instance()->publish(TowerSoldEvent{type, idx, refund});
+     }
+
+     /**
+      * @brief 把防御塔迁移到另一个瓦片，保留等级和累计数据，不收取费用
+      * @param tower 防御塔
+      * @param idx 目标瓦片的网格索引，调用方需保证瓦片可以放置防御塔
+      * @return 迁移后会阻断某个生成点到终点的路线时不迁移，发布TowerPlaceRejectedEvent并返回false
+      */
+     bool relocate_tower(Tower *tower, const SDL_Point &idx)
+     {
+          static Map &map = ConfigManager::instance()->map;
+
+          const SDL_Point idx_src = tower->get_idx_tile();
+
+          // 阻挡查询把原瓦片视为可通行，原瓦片让出的通路也计算在内；被拒绝时不修改地图
+          if (map.would_block_path(idx, idx_src))
+          {
+               EventBus::instance()->publish(TowerPlaceRejectedEvent{idx});
+               return false;
+          }
+          map.remove_tower(idx_src);
+          map.place_tower(idx);
+
+          tower_grid[get_idx_grid(idx_src)] = TowerHandle();
+          tower_grid[get_idx_grid(idx)] = tower->get_handle();
+          tower->set_registry(tower->get_handle(), idx);
+          tower->set_position(get_tile_center(idx));
+
+          EventBus::instance()->publish(TowerRelocatedEvent{tower->get_tower_type(), idx_src, idx});
 
-          static const ResourcesManager::SoundPool &sound_pool = ResourcesManager::instance()->get_sound_pool();
+          return true;
+     }
 
-          Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_TowerLevelUp)->second, 0);
+     /**
+      * @brief 获取单独升级某座防御塔的成本
+      * @param tower 防御塔
+      * @return 升级成本，如果已达到最高等级则返回-1
+      */
+     double get_upgrade_cost(const Tower *tower) const
+     {
+          return tower->get_stats().upgrade_cost;
+     }
+
+     /**
+      * @brief 单独设置某座防御塔的等级，不影响同类型的其他防御塔
+      * @param tower 防御塔
+      * @param level 等级，小于0时恢复跟随该类型的全局等级
+      */
+     void set_tower_level(Tower *tower, int level)
+     {
+          if (level < 0)
+               tower->set_stats(&stats_cache.get_global(tower->get_tower_type()), true);
+          else
+               tower->set_stats(&stats_cache.get(tower->get_tower_type(), level), false);
+     }
+
+     /**
+      * @brief 按地图尺寸重建瓦片到防御塔的索引表，在地图加载后调用
+      */
+     void reset_tower_grid()
+     {
+          const Map &map = ConfigManager::instance()->map;
+
+          width_grid = map.get_width();
+          height_grid = map.get_height();
+          tower_grid.assign(width_grid * height_grid, TowerHandle());
+     }
+
+     /**
+      * @brief 查找指定瓦片上的防御塔，O(1)
+      * @param idx 瓦片的网格索引
+      * @return 防御塔，瓦片越界或没有防御塔时返回nullptr
+      */
+     Tower *find_tower(const SDL_Point &idx)
+     {
+          if (idx.x < 0 || idx.y < 0 || idx.x >= (int)width_grid || idx.y >= (int)height_grid)
+               return nullptr;
+
+          return get_tower(tower_grid[get_idx_grid(idx)]);
+     }
+
+     /**
+      * @brief 通过句柄获取防御塔
+      * @param handle 防御塔句柄
+      * @return 防御塔，句柄失效时返回nullptr
+      */
+     Tower *get_tower(TowerHandle handle)
+     {
+          Tower **tower = tower_list.find(handle);
+          return tower ? *tower : nullptr;
+     }
+
+     /**
+      * @brief 把结算后的伤害和击杀记到造成伤害的防御塔上，防御塔已被移除时忽略
+      * @param handle 造成伤害的防御塔
+      * @param damage 实际造成的伤害
+      * @param num_kill 击杀数
+      */
+     void record_damage(TowerHandle handle, double damage, int num_kill)
+     {
+          Tower *tower = get_tower(handle);
+          if (!tower)
+               return;
+
+          tower->record_damage(damage, num_kill);
+          EventBus::instance()->publish(TowerDamageEvent{tower->get_tower_type(), handle, damage, num_kill});
+     }
+
+     /**
+      * @brief 获取所有防御塔
+      */
+     const SlotMap<Tower *> &get_tower_list() const
+     {
+          return tower_list;
+     }
+
+     /**
+      * @brief 配置重新加载后重建属性缓存，已有防御塔持有的指针保持有效
+      */
+     void refresh_stats()
+     {
+          stats_cache.rebuild();
      }
 
 protected:
-     TowerManager() = default;
+     TowerManager()
+     {
+          stats_cache.rebuild();
+     }
+
      ~TowerManager() = default;
 
 private:
-     std::vector<Tower *> tower_list; ///< 存储所有防御塔的列表
+     const size_t grain_update = 16; ///< 并行更新时每个区块的防御塔数量
+     SlotMap<Tower *> tower_list;    ///< 存储所有防御塔的列表
+     TowerStatsCache stats_cache;    ///< 按类型和等级展开的防御塔属性
+
+     std::vector<TowerHandle> tower_grid; ///< 按瓦片索引存放的防御塔句柄，空句柄表示该瓦片没有防御塔
+     size_t width_grid = 0;               ///< 索引表宽度（瓦片）
+     size_t height_grid = 0;              ///< 索引表高度（瓦片）
+
+private:
+     /**
+      * @brief 瓦片网格索引转换为索引表下标
+      */
+     size_t get_idx_grid(const SDL_Point &idx) const
+     {
+          return (size_t)idx.y * width_grid + idx.x;
+     }
+
+     /**
+      * @brief 获取瓦片中心的世界坐标，即防御塔的位置
+      */
+     static Vector2 get_tile_center(const SDL_Point &idx)
+     {
+          static const SDL_Rect &rect = ConfigManager::instance()->rect_tile_map;
+
+          return Vector2(rect.x + idx.x * SIZE_TILE + SIZE_TILE / 2, rect.y + idx.y * SIZE_TILE + SIZE_TILE / 2);
+     }
 };
 
 #endif // !_TOWER_MANAGER_H_
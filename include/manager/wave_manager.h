@@ -7,6 +7,7 @@
 #include "config_manager.h" // 配置管理器，用于读取波次配置
 #include "enemy_manager.h"  // 敌人生成管理器，用于生成敌人
 #include "coin_manager.h"   // 金币管理器，用于增加金币奖励
+#include "event_bus.h"      // 事件总线，用于发布波次开始事件
 
 // WaveManager 类：负责管理游戏波次和敌人生成
 // 该类继承自 Manager 模板类，实现了单例模式
@@ -16,6 +17,12 @@ class WaveManager : public Manager<WaveManager>
      friend class Manager<WaveManager>;
 
 public:
+     // 获取当前波次索引
+     int get_idx_wave() const
+     {
+          return idx_wave;
+     }
+
      // 更新函数：处理波次和敌人生成的逻辑
      // @param delta: 时间增量，单位：秒
      void on_update(double delta)
@@ -86,6 +93,7 @@ protected:
               {
                    // 标记波次已开始
                    is_wave_started = true;
+                   EventBus::instance()->publish(WaveStartedEvent{idx_wave});
                    // 设置敌人生成等待时间
                    timer_spawn_enemy.set_wait_time(wave_list[idx_wave].spawn_event_list[0].interval);
                    // 重启敌人生成计时器
@@ -100,21 +108,26 @@ protected:
               {
                    // 获取当前波次的生成事件列表
                    const std::vector<Wave::SpawnEvent> &spawn_event_list = wave_list[idx_wave].spawn_event_list;
-                   // 获取当前生成事件
-                   const Wave::SpawnEvent &spawn_event = spawn_event_list[idx_spawn_event];
-
-                   // 生成敌人
-                   EnemyManager::instance()->spawn_enemy(spawn_event.enemy_type, spawn_event.spawn_point);
-
-                   // 进入下一个生成事件
-                   idx_spawn_event++;
-
-                   // 如果所有生成事件已完成，标记最后一个敌人已生成
-                   if (idx_spawn_event >= spawn_event_list.size())
+                   // 生成当前事件的敌人，后续间隔为0的事件在同一帧内一并生成，
+                   // 否则每帧最多生成一个敌人，大规模压力测试的波次需要很久才能出齐
+                   do
                    {
-                        is_spawned_last_enemy = true;
-                        return;
-                   }
+                        // 获取当前生成事件
+                        const Wave::SpawnEvent &spawn_event = spawn_event_list[idx_spawn_event];
+
+                        // 生成敌人
+                        EnemyManager::instance()->spawn_enemy(spawn_event.enemy_type, spawn_event.spawn_point);
+
+                        // 进入下一个生成事件
+                        idx_spawn_event++;
+
+                        // 如果所有生成事件已完成，标记最后一个敌人已生成
+                        if (idx_spawn_event >= spawn_event_list.size())
+                        {
+                             is_spawned_last_enemy = true;
+                             return;
+                        }
+                   } while (spawn_event_list[idx_spawn_event].interval <= 0);
 
                    // 设置下一个生成事件的等待时间
                    timer_spawn_enemy.set_wait_time(spawn_event_list[idx_spawn_event].interval);
@@ -0,0 +1,149 @@
+#ifndef _MAPPED_FILE_H_
+#define _MAPPED_FILE_H_
+
+#include <string>
+#include <cstddef>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+/**
+ * @brief 只读文件映射
+ *
+ * POSIX平台上用mmap把整个文件映射进地址空间，解析器直接在映射的内存上
+ * 扫描，不需要逐行拷贝到临时字符串；其他平台退化为一次性读入内存。
+ * 对象不可拷贝，析构时自动解除映射。
+ */
+class MappedFile
+{
+public:
+     MappedFile() = default;
+
+     /**
+      * @brief 构造并打开文件
+      * @param path 文件路径
+      */
+     explicit MappedFile(const std::string &path)
+     {
+          open(path);
+     }
+
+     ~MappedFile()
+     {
+          close();
+     }
+
+     MappedFile(const MappedFile &) = delete;
+     MappedFile &operator=(const MappedFile &) = delete;
+
+     /**
+      * @brief 打开并映射文件，之前打开的文件会先被关闭
+      * @param path 文件路径
+      * @return 是否成功，空文件视为成功
+      */
+     bool open(const std::string &path)
+     {
+          close();
+
+#ifdef _WIN32
+          std::ifstream file(path, std::ios::binary);
+          if (!file.good())
+               return false;
+
+          buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+          data_ptr = buffer.data();
+          size_byte = buffer.size();
+          is_open_flag = true;
+          return true;
+#else
+          int fd = ::open(path.c_str(), O_RDONLY);
+          if (fd < 0)
+               return false;
+
+          struct stat file_stat;
+          if (::fstat(fd, &file_stat) != 0)
+          {
+               ::close(fd);
+               return false;
+          }
+
+          size_byte = (size_t)file_stat.st_size;
+          if (size_byte > 0)
+          {
+               void *addr = ::mmap(nullptr, size_byte, PROT_READ, MAP_PRIVATE, fd, 0);
+               if (addr == MAP_FAILED)
+               {
+                    ::close(fd);
+                    size_byte = 0;
+                    return false;
+               }
+               // 解析器从头到尾顺序扫描一遍
+               ::madvise(addr, size_byte, MADV_SEQUENTIAL);
+               data_ptr = (const char *)addr;
+          }
+
+          // 映射建立后即可关闭文件描述符
+          ::close(fd);
+          is_open_flag = true;
+          return true;
+#endif
+     }
+
+     /**
+      * @brief 解除映射
+      */
+     void close()
+     {
+#ifdef _WIN32
+          buffer.clear();
+#else
+          if (data_ptr)
+               ::munmap((void *)data_ptr, size_byte);
+#endif
+          data_ptr = nullptr;
+          size_byte = 0;
+          is_open_flag = false;
+     }
+
+     bool is_open() const
+     {
+          return is_open_flag;
+     }
+
+     const char *data() const
+     {
+          return data_ptr;
+     }
+
+     size_t size() const
+     {
+          return size_byte;
+     }
+
+     const char *begin() const
+     {
+          return data_ptr;
+     }
+
+     const char *end() const
+     {
+          return data_ptr + size_byte;
+     }
+
+private:
+     const char *data_ptr = nullptr; // 文件内容起始地址
+     size_t size_byte = 0;           // 文件大小（字节）
+     bool is_open_flag = false;      // 是否已成功打开
+#ifdef _WIN32
+     std::string buffer; // 非POSIX平台上读入的文件内容
+#endif
+};
+
+#endif // !_MAPPED_FILE_H_
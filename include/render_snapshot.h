@@ -0,0 +1,324 @@
+#ifndef _RENDER_SNAPSHOT_H_
+#define _RENDER_SNAPSHOT_H_
+
+#include "text_cache.h"
+
+#include <SDL.h>
+#include <SDL2_gfxPrimitives.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief 渲染快照，记录一帧内需要绘制的全部内容
+ *
+ * 模拟线程在每帧末尾把实体的位置、动画帧、界面数值等录制为绘制指令，
+ * 渲染线程只读取快照并调用SDL绘制，两个线程之间不共享任何可变的游戏对象。
+ * 快照只保存纹理指针和数值，纹理本身在加载后不再修改，可以安全地跨线程读取。
+ *
+ * 指令分为世界层和界面层：世界层在瓦片地图之上按摄像机缩放绘制，
+ * 界面层以屏幕坐标绘制，不受摄像机影响。
+ */
+class RenderSnapshot
+{
+public:
+     /**
+      * @brief 绘制层
+      */
+     enum class Layer
+     {
+          World, ///< 世界层，坐标为视图坐标，按摄像机缩放
+          UI     ///< 界面层，坐标为屏幕坐标
+     };
+
+public:
+     RenderSnapshot() = default;
+     ~RenderSnapshot() = default;
+
+     /**
+      * @brief 清空快照，保留已分配的容量供下一帧复用
+      */
+     void clear()
+     {
+          zoom = 1;
+          rect_view = {0, 0, 0, 0};
+          layer = Layer::World;
+          command_list_world.clear();
+          command_list_ui.clear();
+          num_text = 0;
+     }
+
+     /**
+      * @brief 设置摄像机参数
+      * @param zoom 缩放倍率
+      * @param rect_view 可见区域（世界坐标）
+      */
+     void set_view(double zoom, const SDL_Rect &rect_view)
+     {
+          this->zoom = zoom;
+          this->rect_view = rect_view;
+     }
+
+     double get_zoom() const { return zoom; }
+     const SDL_Rect &get_view_rect() const { return rect_view; }
+
+     /**
+      * @brief 设置后续指令所在的绘制层
+      */
+     void set_layer(Layer layer)
+     {
+          this->layer = layer;
+     }
+
+     /**
+      * @brief 绘制纹理
+      * @param texture 纹理
+      * @param rect_src 源矩形，为nullptr时使用整张纹理
+      * @param rect_dst 目标矩形
+      * @param angle 旋转角度（默认为0）
+      */
+     void draw_texture(SDL_Texture *texture, const SDL_Rect *rect_src, const SDL_Rect &rect_dst, double angle = 0)
+     {
+          if (!texture)
+               return;
+
+          Command &command = push_command(CommandType::Texture);
+          command.texture = texture;
+          command.has_rect_src = rect_src != nullptr;
+          if (rect_src)
+               command.rect_src = *rect_src;
+          command.rect_dst = rect_dst;
+          command.angle = angle;
+     }
+
+     /**
+      * @brief 绘制填充矩形
+      */
+     void fill_rect(const SDL_Rect &rect, const SDL_Color &color)
+     {
+          Command &command = push_command(CommandType::FillRect);
+          command.rect_dst = rect;
+          command.color = color;
+     }
+
+     /**
+      * @brief 绘制矩形边框
+      */
+     void draw_rect(const SDL_Rect &rect, const SDL_Color &color)
+     {
+          Command &command = push_command(CommandType::DrawRect);
+          command.rect_dst = rect;
+          command.color = color;
+     }
+
+     /**
+      * @brief 绘制填充圆
+      * @param center 圆心
+      * @param radius 半径
+      * @param color 颜色
+      */
+     void fill_circle(const SDL_Point &center, int radius, const SDL_Color &color)
+     {
+          Command &command = push_command(CommandType::FillCircle);
+          command.rect_dst = {center.x, center.y, 0, 0};
+          command.radius = radius;
+          command.color = color;
+     }
+
+     /**
+      * @brief 绘制抗锯齿圆框
+      * @param center 圆心
+      * @param radius 半径
+      * @param color 颜色
+      */
+     void draw_circle(const SDL_Point &center, int radius, const SDL_Color &color)
+     {
+          Command &command = push_command(CommandType::DrawCircle);
+          command.rect_dst = {center.x, center.y, 0, 0};
+          command.radius = radius;
+          command.color = color;
+     }
+
+     /**
+      * @brief 绘制填充圆角矩形
+      * @param rect 矩形区域
+      * @param radius 圆角半径
+      * @param color 颜色
+      */
+     void fill_rounded_rect(const SDL_Rect &rect, int radius, const SDL_Color &color)
+     {
+          Command &command = push_command(CommandType::FillRoundedRect);
+          command.rect_dst = rect;
+          command.radius = radius;
+          command.color = color;
+     }
+
+     /**
+      * @brief 绘制文本，文本纹理由渲染线程创建并缓存
+      * @param text 文本内容
+      * @param position 锚点位置
+      * @param color 文本颜色
+      * @param pivot_x 锚点在文本宽度上的比例（0为左对齐，0.5为居中）
+      * @param pivot_y 锚点在文本高度上的比例（0为顶端对齐，0.5为居中）
+      */
+     void draw_text(const std::string &text, const SDL_Point &position, const SDL_Color &color,
+                    double pivot_x = 0, double pivot_y = 0)
+     {
+          Command &command = push_command(CommandType::Text);
+          command.rect_dst = {position.x, position.y, 0, 0};
+          command.color = color;
+          command.pivot_x = pivot_x, command.pivot_y = pivot_y;
+          command.idx_text = push_text(text);
+     }
+
+     /**
+      * @brief 逐字符绘制文本，字符纹理由渲染线程缓存并复用，适合每帧都在变化的文本
+      * @param text 文本内容，只支持可打印ASCII字符
+      * @param position 左上角位置
+      * @param color 文本颜色
+      */
+     void draw_glyph_text(const std::string &text, const SDL_Point &position, const SDL_Color &color)
+     {
+          Command &command = push_command(CommandType::GlyphText);
+          command.rect_dst = {position.x, position.y, 0, 0};
+          command.color = color;
+          command.idx_text = push_text(text);
+     }
+
+     /**
+      * @brief 执行指定层的全部绘制指令（仅在渲染线程调用）
+      * @param renderer SDL渲染器
+      * @param text_cache 文本纹理缓存
+      * @param layer 要执行的绘制层
+      */
+     void execute(SDL_Renderer *renderer, TextCache &text_cache, Layer layer) const
+     {
+          const std::vector<Command> &command_list = layer == Layer::World ? command_list_world : command_list_ui;
+
+          for (const Command &command : command_list)
+          {
+               const SDL_Rect &rect = command.rect_dst;
+               const SDL_Color &color = command.color;
+
+               switch (command.type)
+               {
+               case CommandType::Texture:
+                    SDL_RenderCopyEx(renderer, command.texture, command.has_rect_src ? &command.rect_src : nullptr,
+                                     &rect, command.angle, nullptr, SDL_RendererFlip::SDL_FLIP_NONE);
+                    break;
+               case CommandType::FillRect:
+                    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+                    SDL_RenderFillRect(renderer, &rect);
+                    break;
+               case CommandType::DrawRect:
+                    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+                    SDL_RenderDrawRect(renderer, &rect);
+                    break;
+               case CommandType::FillCircle:
+                    filledCircleRGBA(renderer, (Sint16)rect.x, (Sint16)rect.y, (Sint16)command.radius,
+                                     color.r, color.g, color.b, color.a);
+                    break;
+               case CommandType::DrawCircle:
+                    aacircleRGBA(renderer, (Sint16)rect.x, (Sint16)rect.y, (Sint16)command.radius,
+                                 color.r, color.g, color.b, color.a);
+                    break;
+               case CommandType::FillRoundedRect:
+                    roundedBoxRGBA(renderer, (Sint16)rect.x, (Sint16)rect.y, (Sint16)(rect.x + rect.w), (Sint16)(rect.y + rect.h),
+                                   (Sint16)command.radius, color.r, color.g, color.b, color.a);
+                    break;
+               case CommandType::Text:
+               {
+                    const TextCache::Entry *entry = text_cache.get(renderer, text_list[command.idx_text], color);
+                    if (!entry)
+                         break;
+
+                    const SDL_Rect rect_text =
+                        {
+                            rect.x - (int)(entry->width * command.pivot_x),
+                            rect.y - (int)(entry->height * command.pivot_y),
+                            entry->width, entry->height};
+                    SDL_RenderCopy(renderer, entry->texture, nullptr, &rect_text);
+               }
+               break;
+               case CommandType::GlyphText:
+               {
+                    SDL_Rect rect_glyph = {rect.x, rect.y, 0, 0};
+                    for (char ch : text_list[command.idx_text])
+                    {
+                         const TextCache::Entry *entry = text_cache.get_glyph(renderer, ch);
+                         if (!entry)
+                              continue;
+
+                         rect_glyph.w = entry->width, rect_glyph.h = entry->height;
+                         SDL_SetTextureColorMod(entry->texture, color.r, color.g, color.b);
+                         SDL_RenderCopy(renderer, entry->texture, nullptr, &rect_glyph);
+                         rect_glyph.x += entry->advance;
+                    }
+               }
+               break;
+               }
+          }
+     }
+
+private:
+     /**
+      * @brief 绘制指令类型
+      */
+     enum class CommandType
+     {
+          Texture,
+          FillRect,
+          DrawRect,
+          FillCircle,
+          DrawCircle,
+          FillRoundedRect,
+          Text,
+          GlyphText
+     };
+
+     /**
+      * @brief 单条绘制指令，只包含值类型数据
+      */
+     struct Command
+     {
+          CommandType type = CommandType::Texture;
+          SDL_Texture *texture = nullptr;    ///< 纹理（仅Texture）
+          SDL_Rect rect_src = {0, 0, 0, 0};  ///< 源矩形（仅Texture）
+          bool has_rect_src = false;         ///< 是否指定了源矩形
+          SDL_Rect rect_dst = {0, 0, 0, 0};  ///< 目标矩形，圆和文本只使用x、y
+          double angle = 0;                  ///< 旋转角度
+          SDL_Color color = {0, 0, 0, 0};    ///< 颜色
+          int radius = 0;                    ///< 圆或圆角半径
+          double pivot_x = 0, pivot_y = 0;   ///< 文本锚点比例
+          size_t idx_text = 0;               ///< 文本在text_list中的索引
+     };
+
+private:
+     double zoom = 1;                         ///< 摄像机缩放倍率
+     SDL_Rect rect_view = {0, 0, 0, 0};       ///< 可见区域（世界坐标）
+     Layer layer = Layer::World;              ///< 当前录制的绘制层
+     std::vector<Command> command_list_world; ///< 世界层指令
+     std::vector<Command> command_list_ui;    ///< 界面层指令
+     std::vector<std::string> text_list;      ///< 文本指令引用的字符串，清空时保留以复用容量
+     size_t num_text = 0;                     ///< 本帧使用的字符串数量
+
+private:
+     // 把文本复制到复用的字符串中，长度不超过上一次的容量时不分配内存
+     size_t push_text(const std::string &text)
+     {
+          if (num_text < text_list.size())
+               text_list[num_text].assign(text);
+          else
+               text_list.push_back(text);
+          return num_text++;
+     }
+
+     Command &push_command(CommandType type)
+     {
+          std::vector<Command> &command_list = layer == Layer::World ? command_list_world : command_list_ui;
+          command_list.emplace_back();
+          command_list.back().type = type;
+          return command_list.back();
+     }
+};
+
+#endif // !_RENDER_SNAPSHOT_H_
@@ -0,0 +1,241 @@
+#ifndef _SLOT_MAP_H_
+#define _SLOT_MAP_H_
+
+#include <vector>
+#include <cstdint>
+#include <utility>
+
+/**
+ * @brief 代际句柄，用于安全地引用SlotMap中的元素
+ *
+ * 句柄由槽位索引和代数组成。元素被移除时槽位代数加一，
+ * 之后所有指向该槽位的旧句柄都会失效，不会误指向复用该槽位的新元素。
+ *
+ * @tparam T 元素类型，仅用于区分不同容器的句柄
+ */
+template <typename T>
+struct SlotHandle
+{
+     static constexpr uint32_t idx_invalid = UINT32_MAX;
+
+     uint32_t index = idx_invalid; ///< 槽位索引
+     uint32_t generation = 0;      ///< 槽位代数
+
+     /**
+      * @brief 是否为空句柄（从未指向任何元素）
+      */
+     bool is_null() const
+     {
+          return index == idx_invalid;
+     }
+
+     bool operator==(const SlotHandle &other) const
+     {
+          return index == other.index && generation == other.generation;
+     }
+
+     bool operator!=(const SlotHandle &other) const
+     {
+          return !(*this == other);
+     }
+};
+
+/**
+ * @brief 带代际句柄的槽位映射容器
+ *
+ * 元素连续存放在紧凑数组中，遍历时没有空洞，移除后按原顺序压缩；
+ * 槽位表记录每个句柄对应的数组位置，通过句柄访问元素为O(1)，
+ * 元素被移除后旧句柄查询返回nullptr，而不是悬空的指针。
+ *
+ * 遍历接口（begin/end/size/operator[]）与std::vector一致，
+ * 可以直接替换原来的实体列表。
+ *
+ * @tparam T 元素类型
+ */
+template <typename T>
+class SlotMap
+{
+public:
+     typedef SlotHandle<T> Handle;
+     typedef typename std::vector<T>::iterator iterator;
+     typedef typename std::vector<T>::const_iterator const_iterator;
+
+public:
+     SlotMap() = default;
+     ~SlotMap() = default;
+
+     /**
+      * @brief 插入元素
+      * @param value 元素
+      * @return 指向新元素的句柄
+      */
+     Handle insert(const T &value)
+     {
+          uint32_t idx_slot;
+          if (!free_slot_list.empty())
+          {
+               idx_slot = free_slot_list.back();
+               free_slot_list.pop_back();
+          }
+          else
+          {
+               idx_slot = (uint32_t)slot_list.size();
+               slot_list.emplace_back();
+          }
+
+          Slot &slot = slot_list[idx_slot];
+          slot.idx_dense = (uint32_t)dense_list.size();
+          slot.is_occupied = true;
+
+          dense_list.push_back(value);
+          dense_slot_list.push_back(idx_slot);
+
+          return {idx_slot, slot.generation};
+     }
+
+     /**
+      * @brief 通过句柄查找元素
+      * @param handle 句柄
+      * @return 元素指针，句柄失效时返回nullptr
+      */
+     T *find(Handle handle)
+     {
+          if (!contains(handle))
+               return nullptr;
+          return &dense_list[slot_list[handle.index].idx_dense];
+     }
+
+     const T *find(Handle handle) const
+     {
+          if (!contains(handle))
+               return nullptr;
+          return &dense_list[slot_list[handle.index].idx_dense];
+     }
+
+     /**
+      * @brief 检查句柄是否仍然有效
+      */
+     bool contains(Handle handle) const
+     {
+          if (handle.index >= slot_list.size())
+               return false;
+
+          const Slot &slot = slot_list[handle.index];
+          return slot.is_occupied && slot.generation == handle.generation;
+     }
+
+     /**
+      * @brief 获取紧凑数组中第idx个元素的句柄
+      */
+     Handle get_handle(size_t idx) const
+     {
+          uint32_t idx_slot = dense_slot_list[idx];
+          return {idx_slot, slot_list[idx_slot].generation};
+     }
+
+     /**
+      * @brief 移除所有满足条件的元素，剩余元素保持原有顺序
+      * @param pred 判断函数，返回true的元素会被移除
+      */
+     template <typename Pred>
+     void remove_if(Pred pred)
+     {
+          size_t idx_write = 0;
+          for (size_t idx_read = 0; idx_read < dense_list.size(); idx_read++)
+          {
+               uint32_t idx_slot = dense_slot_list[idx_read];
+               if (pred(dense_list[idx_read]))
+               {
+                    // 代数加一使旧句柄失效
+                    Slot &slot = slot_list[idx_slot];
+                    slot.is_occupied = false;
+                    slot.generation++;
+                    free_slot_list.push_back(idx_slot);
+                    continue;
+               }
+
+               if (idx_write != idx_read)
+               {
+                    dense_list[idx_write] = std::move(dense_list[idx_read]);
+                    dense_slot_list[idx_write] = idx_slot;
+               }
+               slot_list[idx_slot].idx_dense = (uint32_t)idx_write;
+               idx_write++;
+          }
+
+          dense_list.resize(idx_write);
+          dense_slot_list.resize(idx_write);
+     }
+
+     /**
+      * @brief 移除句柄指向的单个元素，O(1)
+      * @param handle 句柄
+      * @return 句柄有效并移除了元素时返回true
+      *
+      * 紧凑数组的最后一个元素移动到被移除的位置，因此会改变遍历顺序（但仍是确定的）；
+      * 不能在遍历过程中调用
+      */
+     bool remove(Handle handle)
+     {
+          if (!contains(handle))
+               return false;
+
+          Slot &slot = slot_list[handle.index];
+          uint32_t idx_dense = slot.idx_dense;
+          uint32_t idx_dense_last = (uint32_t)dense_list.size() - 1;
+          if (idx_dense != idx_dense_last)
+          {
+               dense_list[idx_dense] = std::move(dense_list[idx_dense_last]);
+               dense_slot_list[idx_dense] = dense_slot_list[idx_dense_last];
+               slot_list[dense_slot_list[idx_dense]].idx_dense = idx_dense;
+          }
+          dense_list.pop_back();
+          dense_slot_list.pop_back();
+
+          // 代数加一使旧句柄失效
+          slot.is_occupied = false;
+          slot.generation++;
+          free_slot_list.push_back(handle.index);
+
+          return true;
+     }
+
+     /**
+      * @brief 清空所有元素，已发出的句柄全部失效
+      */
+     void clear()
+     {
+          remove_if([](const T &)
+                    { return true; });
+     }
+
+     size_t size() const { return dense_list.size(); }
+     bool empty() const { return dense_list.empty(); }
+
+     T &operator[](size_t idx) { return dense_list[idx]; }
+     const T &operator[](size_t idx) const { return dense_list[idx]; }
+
+     iterator begin() { return dense_list.begin(); }
+     iterator end() { return dense_list.end(); }
+     const_iterator begin() const { return dense_list.begin(); }
+     const_iterator end() const { return dense_list.end(); }
+
+private:
+     /**
+      * @brief 槽位：记录元素在紧凑数组中的位置和当前代数
+      */
+     struct Slot
+     {
+          uint32_t idx_dense = 0;   ///< 元素在紧凑数组中的索引
+          uint32_t generation = 0;  ///< 当前代数
+          bool is_occupied = false; ///< 槽位是否有元素
+     };
+
+private:
+     std::vector<T> dense_list;             ///< 紧凑存放的元素
+     std::vector<uint32_t> dense_slot_list; ///< 紧凑数组中每个元素所属的槽位
+     std::vector<Slot> slot_list;           ///< 槽位表
+     std::vector<uint32_t> free_slot_list;  ///< 空闲槽位，优先复用
+};
+
+#endif // !_SLOT_MAP_H_
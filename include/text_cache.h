@@ -0,0 +1,169 @@
+#ifndef _TEXT_CACHE_H_
+#define _TEXT_CACHE_H_
+
+#include <SDL.h>
+#include <SDL_ttf.h>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @brief 文本纹理缓存，只在渲染线程使用
+ *
+ * 以文本内容和颜色为键缓存TTF渲染出的纹理，数值不变时不再重复创建纹理。
+ * 条目数超过上限时整体清空，避免不断变化的数值（如金币数）让缓存无限增长。
+ *
+ * 每帧都在变化的文本（如调试信息）改用单字符缓存：可打印ASCII字符各渲染一次白色纹理，
+ * 绘制时逐字符拷贝并用颜色调制着色，数值变化不再产生新的纹理。
+ */
+class TextCache
+{
+public:
+     /**
+      * @brief 缓存条目
+      */
+     struct Entry
+     {
+          SDL_Texture *texture = nullptr; ///< 文本纹理
+          int width = 0, height = 0;      ///< 纹理尺寸
+          int advance = 0;                ///< 字符的步进宽度（仅字符缓存）
+     };
+
+public:
+     TextCache() = default;
+
+     ~TextCache()
+     {
+          clear();
+          clear_glyph();
+     }
+
+     /**
+      * @brief 设置渲染文本使用的字体
+      */
+     void set_font(TTF_Font *font)
+     {
+          if (this->font != font)
+          {
+               clear();
+               clear_glyph();
+          }
+          this->font = font;
+     }
+
+     /**
+      * @brief 获取文本纹理，不存在时创建
+      * @param renderer SDL渲染器
+      * @param text 文本内容
+      * @param color 文本颜色
+      * @return 缓存条目，创建失败返回nullptr
+      */
+     const Entry *get(SDL_Renderer *renderer, const std::string &text, const SDL_Color &color)
+     {
+          if (!font || text.empty())
+               return nullptr;
+
+          std::string key = text;
+          key.push_back('\0');
+          key.append((const char *)&color, sizeof(SDL_Color));
+
+          const auto &itor = entry_pool.find(key);
+          if (itor != entry_pool.end())
+               return &itor->second;
+
+          if (entry_pool.size() >= max_entries)
+               clear();
+
+          SDL_Surface *suf_text = TTF_RenderText_Blended(font, text.c_str(), color);
+          if (!suf_text)
+               return nullptr;
+
+          Entry entry;
+          entry.width = suf_text->w, entry.height = suf_text->h;
+          entry.texture = SDL_CreateTextureFromSurface(renderer, suf_text);
+          SDL_FreeSurface(suf_text);
+
+          if (!entry.texture)
+               return nullptr;
+
+          num_upload++;
+          return &(entry_pool[key] = entry);
+     }
+
+     /**
+      * @brief 获取单个字符的白色纹理，不存在时创建
+      * @param renderer SDL渲染器
+      * @param ch 字符，只支持可打印ASCII字符
+      * @return 缓存条目，不支持的字符或创建失败返回nullptr
+      */
+     const Entry *get_glyph(SDL_Renderer *renderer, char ch)
+     {
+          if (!font || ch < glyph_first || ch > glyph_last)
+               return nullptr;
+
+          Entry &entry = glyph_list[ch - glyph_first];
+          if (entry.texture)
+               return &entry;
+
+          SDL_Surface *suf_glyph = TTF_RenderGlyph_Blended(font, (Uint16)ch, {255, 255, 255, 255});
+          if (!suf_glyph)
+               return nullptr;
+
+          int advance = suf_glyph->w;
+          TTF_GlyphMetrics(font, (Uint16)ch, nullptr, nullptr, nullptr, nullptr, &advance);
+
+          entry.texture = SDL_CreateTextureFromSurface(renderer, suf_glyph);
+          entry.width = suf_glyph->w, entry.height = suf_glyph->h;
+          entry.advance = advance;
+          SDL_FreeSurface(suf_glyph);
+
+          if (!entry.texture)
+               return nullptr;
+
+          num_upload++;
+          return &entry;
+     }
+
+     /**
+      * @brief 获取并清零上次调用以来创建的纹理数量
+      */
+     int take_upload_count()
+     {
+          int count = num_upload;
+          num_upload = 0;
+          return count;
+     }
+
+     /**
+      * @brief 释放全部缓存的纹理
+      */
+     void clear()
+     {
+          for (auto &pair : entry_pool)
+               SDL_DestroyTexture(pair.second.texture);
+          entry_pool.clear();
+     }
+
+     /**
+      * @brief 释放全部字符纹理
+      */
+     void clear_glyph()
+     {
+          for (Entry &entry : glyph_list)
+          {
+               SDL_DestroyTexture(entry.texture);
+               entry = Entry();
+          }
+     }
+
+private:
+     static constexpr char glyph_first = ' '; ///< 字符缓存的第一个字符
+     static constexpr char glyph_last = '~';  ///< 字符缓存的最后一个字符
+
+     const size_t max_entries = 128;                   ///< 缓存条目上限
+     TTF_Font *font = nullptr;                         ///< 字体
+     std::unordered_map<std::string, Entry> entry_pool; ///< 以文本和颜色为键的缓存
+     Entry glyph_list[glyph_last - glyph_first + 1];    ///< 可打印ASCII字符的纹理
+     int num_upload = 0;                               ///< 上次取出以来创建的纹理数量
+};
+
+#endif // !_TEXT_CACHE_H_
@@ -1,6 +1,7 @@
 #ifndef _TIMER_H_
 #define _TIMER_H_
 
+#include <atomic>
 #include <functional>
 
 /**
@@ -13,8 +14,32 @@
 class Timer
 {
 public:
-     Timer() = default;
-     ~Timer() = default;
+     Timer()
+     {
+          num_alive.fetch_add(1, std::memory_order_relaxed);
+     }
+
+     Timer(const Timer &timer)
+         : pass_time(timer.pass_time), wait_time(timer.wait_time), paused(timer.paused),
+           shotted(timer.shotted), one_shot(timer.one_shot), on_timeout(timer.on_timeout)
+     {
+          num_alive.fetch_add(1, std::memory_order_relaxed);
+     }
+
+     Timer &operator=(const Timer &timer) = default;
+
+     ~Timer()
+     {
+          num_alive.fetch_sub(1, std::memory_order_relaxed);
+     }
+
+     /**
+      * @brief 获取当前存在的计时器数量（调试用）
+      */
+     static int get_alive_count()
+     {
+          return num_alive.load(std::memory_order_relaxed);
+     }
 
      /**
       * @brief 从零重新启动计时器
@@ -99,6 +124,8 @@ public:
      }
 
 private:
+     static inline std::atomic<int> num_alive{0}; // 当前存在的计时器数量
+
      double pass_time = 0;             // 自上次超时以来累积的时间
      double wait_time = 0;             // 触发超时前等待的时间
      bool paused = false;              // 计时器当前是否暂停
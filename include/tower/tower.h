@@ -9,9 +9,14 @@
 #include "facing.h"
 #include "game_map/vector2.h"
 #include "animation.h"
+#include "camera.h"
 #include "tower/tower_type.h"
+#include "tower/tower_stats.h"
 #include "manager/enemy_manager.h"
 #include "manager/bullet_manager.h"
+#include "command_buffer.h"
+#include "event_bus.h"
+#include "collision.h"
 
 /**
  * @class Tower
@@ -106,30 +111,157 @@ public:
      }
 
      /**
-      * @brief 更新塔的状态
+      * @brief 设置塔的属性
+      * @param stats 指向属性缓存中某一项的指针，由TowerManager提供
+      * @param is_global_level 是否跟随该类型的全局等级
+      */
+     void set_stats(const TowerStats *stats, bool is_global_level)
+     {
+          this->stats = stats;
+          this->is_global_level = is_global_level;
+     }
+
+     /**
+      * @brief 获取塔当前的属性
+      */
+     const TowerStats &get_stats() const
+     {
+          return *stats;
+     }
+
+     /**
+      * @brief 获取塔的类型
+      */
+     TowerType get_tower_type() const
+     {
+          return tower_type;
+     }
+
+     /**
+      * @brief 获取塔的等级
+      */
+     int get_level() const
+     {
+          return stats->level;
+     }
+
+     /**
+      * @brief 塔是否跟随该类型的全局等级（没有单独升级过）
+      */
+     bool is_following_global_level() const
+     {
+          return is_global_level;
+     }
+
+     /**
+      * @brief 设置塔在TowerManager中的句柄和所在瓦片，由TowerManager在放置时调用
+      * @param handle 塔的句柄，开火时作为伤害来源写入指令
+      * @param idx_tile 塔所在瓦片的网格索引
+      */
+     void set_registry(TowerHandle handle, const SDL_Point &idx_tile)
+     {
+          this->handle = handle;
+          this->idx_tile = idx_tile;
+     }
+
+     /**
+      * @brief 获取塔的句柄
+      */
+     TowerHandle get_handle() const
+     {
+          return handle;
+     }
+
+     /**
+      * @brief 获取塔所在瓦片的网格索引
+      */
+     const SDL_Point &get_idx_tile() const
+     {
+          return idx_tile;
+     }
+
+     /**
+      * @brief 记录塔造成的伤害和击杀（在同步点结算伤害指令时调用）
+      * @param damage 实际造成的伤害
+      * @param num_kill 击杀数
+      */
+     void record_damage(double damage, int num_kill)
+     {
+          damage_dealt += damage;
+          this->num_kill += num_kill;
+     }
+
+     /**
+      * @brief 记录在塔上花费的金币（放置和单独升级），出售时按比例返还
+      * @param coin 花费的金币
+      */
+     void add_coin_spent(double coin)
+     {
+          coin_spent += coin;
+     }
+
+     /**
+      * @brief 获取在塔上花费的金币
+      */
+     double get_coin_spent() const
+     {
+          return coin_spent;
+     }
+
+     /**
+      * @brief 获取塔的累计击杀数
+      */
+     int get_num_kill() const
+     {
+          return num_kill;
+     }
+
+     /**
+      * @brief 获取塔的累计伤害
+      */
+     double get_damage_dealt() const
+     {
+          return damage_dealt;
+     }
+
+     /**
+      * @brief 获取塔自放置以来的游戏时间（秒）
+      */
+     double get_uptime() const
+     {
+          return uptime;
+     }
+
+     /**
+      * @brief 更新塔的状态，可以冷却完毕时寻找目标（可并行调用）
       * @param delta 时间增量
       */
      void on_update(double delta)
      {
+          uptime += delta;
           timer_fire.on_update(delta);
           anim_current->on_update(delta);
 
-          if (can_fire)
-               on_fire();
+          enemy_target = can_fire ? find_target_enemy() : EnemyHandle();
      }
 
      /**
       * @brief 渲染塔
-      * @param renderer SDL渲染器指针
+      * @param snapshot 渲染快照
+      * @param camera 摄像机，用于视锥裁剪和坐标转换
       */
-     void on_render(SDL_Renderer *renderer)
+     void on_render(RenderSnapshot &snapshot, const Camera &camera)
      {
           static SDL_Point point;
 
-          point.x = (int)(position.x - size.x / 2);
-          point.y = (int)(position.y - size.y / 2);
+          if (!camera.is_visible(position, size))
+               return;
+
+          const Vector2 pos_view = camera.world_to_view(position);
+          point.x = (int)(pos_view.x - size.x / 2);
+          point.y = (int)(pos_view.y - size.y / 2);
 
-          anim_current->on_render(renderer, point);
+          anim_current->on_render(snapshot, point);
      }
 
 protected:
@@ -154,6 +286,15 @@ private:
      bool can_fire = true;                       ///< 是否可以攻击
      Facing facing = Facing::Right;              ///< 塔的朝向
      Animation *anim_current = &anim_idle_right; ///< 当前播放的动画
+     EnemyHandle enemy_target;                   ///< 本帧索敌结果，仅在on_update与on_fire之间有效
+     const TowerStats *stats = nullptr;          ///< 当前等级的属性，指向TowerManager的属性缓存
+     bool is_global_level = true;                ///< 是否跟随该类型的全局等级
+     TowerHandle handle;                         ///< 塔在TowerManager中的句柄
+     SDL_Point idx_tile = {0, 0};                ///< 塔所在瓦片的网格索引
+     int num_kill = 0;                           ///< 累计击杀数
+     double damage_dealt = 0;                    ///< 累计造成的伤害
+     double uptime = 0;                          ///< 自放置以来的游戏时间（秒）
+     double coin_spent = 0;                      ///< 在塔上花费的金币
 
 private:
      /**
@@ -202,42 +343,28 @@ private:
 
      /**
       * @brief 寻找目标敌人
-      * @return 找到的目标敌人，如果没有找到则返回nullptr
+      * @return 找到的目标敌人的句柄，如果没有找到则返回空句柄
       */
-     Enemy *find_target_enemy()
+     EnemyHandle find_target_enemy()
      {
-          double process = -1;
-          double view_range = 0;
-          Enemy *enemy_target = nullptr;
-
-          static ConfigManager *instance = ConfigManager::instance();
-
-          // 根据塔的类型获取视野范围
-          switch (tower_type)
-          {
-          case Archer:
-               view_range = instance->archer_template.view_range[instance->level_archer];
-               break;
-          case Axeman:
-               view_range = instance->axeman_template.view_range[instance->level_axeman];
-               break;
-          case Gunner:
-               view_range = instance->gunner_template.view_range[instance->level_gunner];
-               break;
-          }
+          double distance_min = std::numeric_limits<double>::max();
+          const double view_range_pixel_sq = stats->view_range_pixel_sq;
+          EnemyHandle enemy_target;
 
           EnemyManager::EnemyList &enemy_list = EnemyManager::instance()->get_enemy_list();
 
-          // 在视野范围内寻找进度最远的敌人
-          for (Enemy *enemy : enemy_list)
+          // 在视野范围内寻找离终点最近的敌人（按剩余路程比较，不同路径上的敌人也能正确排序）
+          for (size_t i = 0; i < enemy_list.size(); i++)
           {
-               if ((enemy->get_position() - position).length() <= view_range * SIZE_TILE)
+               const Enemy *enemy = enemy_list[i];
+               Vector2 offset = enemy->get_position() - position;
+               if (offset.x * offset.x + offset.y * offset.y <= view_range_pixel_sq)
                {
-                    double new_process = enemy->get_route_process();
-                    if (new_process > process)
+                    double distance = enemy->get_distance_to_home();
+                    if (enemy_target.is_null() || distance < distance_min)
                     {
-                         enemy_target = enemy;
-                         process = new_process;
+                         enemy_target = enemy_list.get_handle(i);
+                         distance_min = distance;
                     }
                }
           }
@@ -245,57 +372,63 @@ private:
           return enemy_target;
      }
 
+public:
      /**
-      * @brief 处理攻击行为
+      * @brief 向on_update中找到的目标开火（须串行调用）
       */
      void on_fire()
      {
-          Enemy *target_enemy = find_target_enemy();
+          // 通过句柄取回目标，目标已被移除时句柄失效，本帧不开火
+          EnemyHandle enemy_target_fire = enemy_target;
+          Enemy *target_enemy = EnemyManager::instance()->get_enemy(enemy_target);
+          enemy_target = EnemyHandle();
 
           if (!target_enemy)
                return;
 
           can_fire = false;
-          static ConfigManager *instance = ConfigManager::instance();
-          static const ResourcesManager::SoundPool &sound_pool = ResourcesManager::instance()->get_sound_pool();
+          static CommandBuffer *command_buffer = CommandBuffer::instance();
 
-          // 根据塔的类型设置攻击间隔和伤害
-          double interval = 0, damage = 0;
-          switch (tower_type)
-          {
-          case Archer:
-               interval = instance->archer_template.interval[instance->level_archer];
-               damage = instance->archer_template.damage[instance->level_archer];
-               switch (rand() % 2)
-               {
-               case 0:
-                    Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_ArrowFire_1)->second, 0);
-                    break;
-               case 1:
-                    Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_ArrowFire_2)->second, 0);
-                    break;
-               }
-               break;
-          case Axeman:
-               interval = instance->axeman_template.interval[instance->level_axeman];
-               damage = instance->axeman_template.damage[instance->level_axeman];
-               Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_AxeFire)->second, 0);
-               break;
-          case Gunner:
-               interval = instance->gunner_template.interval[instance->level_gunner];
-               damage = instance->gunner_template.damage[instance->level_gunner];
-               Mix_PlayChannel(-1, sound_pool.find(ResID::Sound_ShellFire)->second, 0);
-               break;
-          }
-          timer_fire.set_wait_time(interval);
-          timer_fire.restart();
+          // 攻击间隔、伤害、是否追踪和是否瞬间命中都来自预先展开的属性
+          const double damage = stats->damage;
+          const bool is_homing = stats->is_homing;
+          const bool is_hitscan = stats->is_hitscan;
 
-          // 计算子弹方向和速度
-          Vector2 direction = target_enemy->get_position() - position;
-          direction = direction.normalize() * fire_speed; // 设置子弹速度
+          // 开火音效等由事件订阅者处理
+          EventBus::instance()->publish(BulletFiredEvent{tower_type, handle, position});
 
-          // 创建子弹，传递速度参数
-          BulletManager::instance()->create_bullet(bullet_type, position, target_enemy->get_position(), damage, -1, direction);
+          timer_fire.set_wait_time(stats->interval);
+          timer_fire.restart();
+
+          Vector2 direction;
+          if (is_hitscan)
+          {
+               // 瞬间命中：不生成子弹，开火当帧沿塔到目标的线段解析命中
+               direction = target_enemy->get_position() - position;
+               fire_hitscan(target_enemy->get_position(), damage);
+          }
+          else
+          {
+               // 计算子弹方向和速度，追踪子弹瞄准预判的拦截点，之后每帧通过句柄修正方向
+               Vector2 position_aim = target_enemy->get_position();
+               if (is_homing)
+                    position_aim = Bullet::predict_intercept(position, fire_speed * 100, position_aim, target_enemy->get_velocity());
+
+               direction = position_aim - position;
+               direction = direction.normalize() * fire_speed; // 设置子弹速度
+
+               // 生成子弹，传递速度参数，在同步点加入子弹列表
+               CommandBuffer::SpawnBullet command;
+               command.type = bullet_type;
+               command.position = position;
+               command.target_position = target_enemy->get_position();
+               command.velocity = direction;
+               command.damage = damage;
+               command.tower_source = handle;
+               if (is_homing)
+                    command.enemy_target = enemy_target_fire;
+               command_buffer->spawn_bullet(command);
+          }
 
           // 更新塔的朝向
           bool is_show_x_anim = abs(direction.x) >= abs(direction.y);
@@ -306,6 +439,71 @@ private:
 
           update_fire_animation();
      }
+
+private:
+     /**
+      * @brief 瞬间命中：从塔到目标位置做线段与敌人包围盒的扫掠检测，命中线段上最先接触的敌人
+      * @param target_position 目标敌人的位置
+      * @param damage 伤害值
+      *
+      * 线段终点是目标中心，目标本身一定相交，因此至少会命中目标；
+      * 挡在路径上的其他敌人会先被命中。炮弹以命中点为中心按爆炸范围造成范围伤害，
+      * 命中音效和对应子弹一样随机选取。伤害和命中音效写入指令缓冲，在同步点结算
+      */
+     void fire_hitscan(const Vector2 &target_position, double damage)
+     {
+          static CommandBuffer *command_buffer = CommandBuffer::instance();
+          EnemyManager::EnemyList &enemy_list = EnemyManager::instance()->get_enemy_list();
+
+          size_t idx_hit = 0;
+          double t_hit_min = 2;
+          for (size_t i = 0; i < enemy_list.size(); i++)
+          {
+               const Enemy *enemy = enemy_list[i];
+               if (enemy->can_remove())
+                    continue;
+
+               double t_hit = 0;
+               if (intersect_segment_aabb(position, target_position, enemy->get_position(), enemy->get_size(), &t_hit) && t_hit < t_hit_min)
+               {
+                    idx_hit = i;
+                    t_hit_min = t_hit;
+               }
+          }
+
+          if (t_hit_min > 1)
+               return;
+
+          const Vector2 &position_hit = enemy_list[idx_hit]->get_position();
+
+          CommandBuffer::ApplyDamage command;
+          command.damage = damage;
+          command.is_slow_down = bullet_type == BulletType::Axe;
+          command.tower_source = handle;
+          if (bullet_type == BulletType::Shell)
+          {
+               command.position = position_hit;
+               command.damage_range = ShellBullet::damage_range_explode;
+          }
+          else
+               command.enemy_target = enemy_list.get_handle(idx_hit);
+          command_buffer->apply_damage(command);
+
+          static const ResID sound_arrow_hit_list[] = {ResID::Sound_ArrowHit_1, ResID::Sound_ArrowHit_2, ResID::Sound_ArrowHit_3};
+          static const ResID sound_axe_hit_list[] = {ResID::Sound_AxeHit_1, ResID::Sound_AxeHit_2, ResID::Sound_AxeHit_3};
+          switch (bullet_type)
+          {
+          case BulletType::Arrow:
+               command_buffer->play_sound(sound_arrow_hit_list[rand() % 3], position_hit);
+               break;
+          case BulletType::Axe:
+               command_buffer->play_sound(sound_axe_hit_list[rand() % 3], position_hit);
+               break;
+          case BulletType::Shell:
+               command_buffer->play_sound(ResID::Sound_ShellHit, position_hit);
+               break;
+          }
+     }
 };
 
 #endif // !_TOWER_H_
@@ -0,0 +1,158 @@
+/**
+ * @file tower_stats.h
+ * @brief 防御塔属性缓存：把配置模板按类型和等级预先展开，防御塔直接持有指向缓存的指针
+ */
+
+#ifndef _TOWER_STATS_H_
+#define _TOWER_STATS_H_
+
+#include "tower/tower_type.h"
+#include "game_map/tile.h"
+#include "manager/config_manager.h"
+
+/**
+ * @struct TowerStats
+ * @brief 某种防御塔在某一等级下的全部属性
+ */
+struct TowerStats
+{
+     int level = 0;                   ///< 等级（0-9）
+     double interval = 1;             ///< 攻击间隔（秒）
+     double damage = 0;               ///< 单次伤害
+     double view_range = 0;           ///< 攻击范围（瓦片）
+     double view_range_pixel = 0;     ///< 攻击范围（像素）
+     double view_range_pixel_sq = 0;  ///< 攻击范围（像素）的平方，索敌时免去开方
+     double cost = 0;                 ///< 放置成本
+     double upgrade_cost = -1;        ///< 升级到下一级的成本，已达最高等级时为-1
+     double refund_ratio = 0;         ///< 出售时返还的金币比例
+     bool is_homing = false;          ///< 子弹是否追踪目标
+     bool is_hitscan = false;         ///< 是否为瞬间命中武器
+};
+
+/**
+ * @class TowerStatsCache
+ * @brief 按类型和等级预先展开的防御塔属性表
+ *
+ * 每种类型保存全部等级的属性，以及一份"全局等级"属性：没有单独设置等级的防御塔
+ * 指向全局等级属性，全局升级时只需原地刷新这一份，所有此类防御塔立即生效；
+ * 单独设置了等级的防御塔直接指向对应等级的属性。所有属性的地址在缓存生命周期内不变，
+ * 配置重新加载后原地重建，防御塔持有的指针始终有效。
+ */
+class TowerStatsCache
+{
+public:
+     static constexpr int num_type = 3;   ///< 防御塔类型数量
+     static constexpr int num_level = 10; ///< 等级数量
+
+public:
+     TowerStatsCache() = default;
+     ~TowerStatsCache() = default;
+
+     TowerStatsCache(const TowerStatsCache &) = delete;
+     TowerStatsCache &operator=(const TowerStatsCache &) = delete;
+
+     /**
+      * @brief 根据配置模板和全局等级重建全部属性
+      */
+     void rebuild()
+     {
+          for (int type = 0; type < num_type; type++)
+          {
+               for (int level = 0; level < num_level; level++)
+                    resolve((TowerType)type, level, level_stats_list[type][level]);
+
+               refresh_global((TowerType)type);
+          }
+     }
+
+     /**
+      * @brief 全局等级变化后刷新该类型的全局等级属性
+      * @param type 防御塔类型
+      */
+     void refresh_global(TowerType type)
+     {
+          global_stats_list[type] = level_stats_list[type][get_global_level(type)];
+     }
+
+     /**
+      * @brief 获取某类型在全局等级下的属性
+      * @param type 防御塔类型
+      */
+     const TowerStats &get_global(TowerType type) const
+     {
+          return global_stats_list[type];
+     }
+
+     /**
+      * @brief 获取某类型在指定等级下的属性
+      * @param type 防御塔类型
+      * @param level 等级，超出范围时截断到0-9
+      */
+     const TowerStats &get(TowerType type, int level) const
+     {
+          level = level < 0 ? 0 : (level >= num_level ? num_level - 1 : level);
+          return level_stats_list[type][level];
+     }
+
+     /**
+      * @brief 获取某类型的全局等级
+      * @param type 防御塔类型
+      */
+     static int get_global_level(TowerType type)
+     {
+          static ConfigManager *instance = ConfigManager::instance();
+
+          switch (type)
+          {
+          case Archer:
+               return instance->level_archer;
+          case Axeman:
+               return instance->level_axeman;
+          case Gunner:
+               return instance->level_gunner;
+          }
+
+          return 0;
+     }
+
+private:
+     TowerStats level_stats_list[num_type][num_level]; ///< 每种类型每个等级的属性
+     TowerStats global_stats_list[num_type];           ///< 每种类型在全局等级下的属性
+
+private:
+     /**
+      * @brief 从配置模板中展开某类型某等级的属性
+      */
+     static void resolve(TowerType type, int level, TowerStats &stats)
+     {
+          static ConfigManager *instance = ConfigManager::instance();
+
+          const ConfigManager::TowerTemplate *tpl = &instance->archer_template;
+          switch (type)
+          {
+          case Archer:
+               tpl = &instance->archer_template;
+               break;
+          case Axeman:
+               tpl = &instance->axeman_template;
+               break;
+          case Gunner:
+               tpl = &instance->gunner_template;
+               break;
+          }
+
+          stats.level = level;
+          stats.interval = tpl->interval[level];
+          stats.damage = tpl->damage[level];
+          stats.view_range = tpl->view_range[level];
+          stats.view_range_pixel = stats.view_range * SIZE_TILE;
+          stats.view_range_pixel_sq = stats.view_range_pixel * stats.view_range_pixel;
+          stats.cost = tpl->cost[level];
+          stats.upgrade_cost = level >= num_level - 1 ? -1 : tpl->upgrade_cost[level];
+          stats.refund_ratio = tpl->refund_ratio;
+          stats.is_homing = tpl->is_homing;
+          stats.is_hitscan = tpl->is_hitscan;
+     }
+};
+
+#endif // !_TOWER_STATS_H_
@@ -0,0 +1,76 @@
+#ifndef _TRIPLE_BUFFER_H_
+#define _TRIPLE_BUFFER_H_
+
+#include <mutex>
+
+/**
+ * @brief 三缓冲，用于生产者线程和消费者线程之间无阻塞地交换整帧数据
+ *
+ * 生产者总是写入独占的写缓冲，写完后与就绪缓冲交换；
+ * 消费者在有新数据时把就绪缓冲换到独占的读缓冲。
+ * 双方都只在交换下标时短暂加锁，任何一方都不会等待另一方完成一帧，
+ * 生产者比消费者快时中间帧会被直接覆盖。
+ *
+ * @tparam T 缓冲数据类型
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+     TripleBuffer() = default;
+     ~TripleBuffer() = default;
+
+     TripleBuffer(const TripleBuffer &) = delete;
+     TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+     /**
+      * @brief 获取写缓冲（仅生产者线程）
+      */
+     T &get_write_buffer()
+     {
+          return buffer_list[idx_write];
+     }
+
+     /**
+      * @brief 发布写缓冲，使其成为最新的就绪数据（仅生产者线程）
+      */
+     void publish()
+     {
+          std::lock_guard<std::mutex> lock(mutex);
+          std::swap(idx_write, idx_ready);
+          has_new_data = true;
+     }
+
+     /**
+      * @brief 若有新发布的数据则换入读缓冲（仅消费者线程）
+      * @return 读缓冲被更新返回true，否则读缓冲保持上一次的数据
+      */
+     bool acquire()
+     {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!has_new_data)
+               return false;
+
+          std::swap(idx_read, idx_ready);
+          has_new_data = false;
+          return true;
+     }
+
+     /**
+      * @brief 获取读缓冲（仅消费者线程）
+      */
+     const T &get_read_buffer() const
+     {
+          return buffer_list[idx_read];
+     }
+
+private:
+     T buffer_list[3];
+     int idx_write = 0;         ///< 生产者独占
+     int idx_ready = 1;         ///< 最新发布的数据
+     int idx_read = 2;          ///< 消费者独占
+     bool has_new_data = false; ///< 就绪缓冲是否尚未被读取
+     std::mutex mutex;
+};
+
+#endif // !_TRIPLE_BUFFER_H_
@@ -5,6 +5,7 @@
 #include "game_map/vector2.h"
 #include "manager/config_manager.h"
 #include "manager/resources_manager.h"
+#include "render_snapshot.h"
 
 #include <SDL.h>
 
@@ -43,19 +44,19 @@ public:
           tex_background = tex_pool.find(ResID::Tex_UIGameOverBar)->second;
      }
 
-     void on_render(SDL_Renderer *renderer)
+     void on_render(RenderSnapshot &snapshot)
      {
           static SDL_Rect rect_dst;
 
           rect_dst.x = (int)(pos_center.x - size_background.x / 2);
           rect_dst.y = (int)(pos_center.y - size_background.y / 2);
           rect_dst.w = (int)size_background.x, rect_dst.h = (int)size_background.y;
-          SDL_RenderCopy(renderer, tex_background, nullptr, &rect_dst);
+          snapshot.draw_texture(tex_background, nullptr, rect_dst);
 
           rect_dst.x = (int)(pos_center.x - size_foreground.x / 2);
           rect_dst.y = (int)(pos_center.y - size_foreground.y / 2);
           rect_dst.w = (int)size_foreground.x, rect_dst.h = (int)size_foreground.y;
-          SDL_RenderCopy(renderer, tex_foreground, nullptr, &rect_dst);
+          snapshot.draw_texture(tex_foreground, nullptr, rect_dst);
      }
 
      bool check_end_dispaly()
@@ -0,0 +1,231 @@
+/**
+ * @file debug_overlay.h
+ * @brief 调试信息层，显示帧耗时曲线、耗时分位数和实体数量
+ */
+
+#ifndef _DEBUG_OVERLAY_H_
+#define _DEBUG_OVERLAY_H_
+
+#include "timer.h"
+#include "render_snapshot.h"
+#include "manager/enemy_manager.h"
+#include "manager/bullet_manager.h"
+#include "manager/coin_manager.h"
+#include "manager/tower_manager.h"
+
+#include <SDL.h>
+#include <array>
+#include <string>
+#include <cstdio>
+#include <algorithm>
+
+/**
+ * @class DebugOverlay
+ * @brief 调试信息层，按键切换显示，只在模拟线程使用
+ *
+ * 每帧记录渲染线程的帧间隔、模拟耗时、渲染耗时和纹理创建数量到环形缓冲，隐藏时也持续记录，
+ * 打开时即可看到最近的历史。文本每秒刷新四次，统计最近若干帧的分位数；
+ * 文本用逐字符缓存绘制，数值变化不会创建新的纹理，整个调试层每帧只有几百条简单绘制指令。
+ */
+class DebugOverlay
+{
+public:
+     DebugOverlay()
+     {
+          timer_refresh.set_one_shot(false);
+          timer_refresh.set_wait_time(0.25);
+          timer_refresh.set_on_timeout(
+              [&]()
+              {
+                   refresh_text();
+              });
+     }
+
+     ~DebugOverlay() = default;
+
+     /**
+      * @brief 设置调试层左上角位置（屏幕坐标）
+      */
+     void set_position(int x, int y)
+     {
+          position.x = x, position.y = y;
+     }
+
+     /**
+      * @brief 切换显示状态，打开时立即刷新文本
+      */
+     void toggle()
+     {
+          is_visible = !is_visible;
+          if (is_visible)
+               refresh_text();
+     }
+
+     /**
+      * @brief 记录一帧的耗时数据
+      * @param time_frame 渲染线程最近两次SDL_RenderPresent之间的间隔（秒）
+      * @param time_sim 模拟线程本帧的耗时（秒）
+      * @param time_render 渲染线程最近一帧的耗时（秒），不含等待垂直同步的时间
+      * @param num_upload 渲染线程上次记录以来创建的纹理数量
+      */
+     void record_frame(double time_frame, double time_sim, double time_render, int num_upload)
+     {
+          Sample &sample = sample_list[idx_sample];
+          sample.time_frame = (float)(time_frame * 1000);
+          sample.time_sim = (float)(time_sim * 1000);
+          sample.time_render = (float)(time_render * 1000);
+          sample.num_upload = num_upload;
+
+          idx_sample = (idx_sample + 1) % num_sample_max;
+          num_sample = std::min(num_sample + 1, num_sample_max);
+     }
+
+     /**
+      * @brief 更新文本刷新计时器
+      * @param delta 时间增量（秒）
+      */
+     void on_update(double delta)
+     {
+          if (is_visible)
+               timer_refresh.on_update(delta);
+     }
+
+     /**
+      * @brief 把调试层录制到快照的界面层
+      */
+     void on_render(RenderSnapshot &snapshot)
+     {
+          if (!is_visible)
+               return;
+
+          const int height_text = (int)text_line_list.size() * height_line;
+          snapshot.fill_rect({position.x, position.y, width_graph + 2 * padding, height_graph + height_text + 3 * padding}, color_background);
+
+          // 帧耗时曲线：每帧一列，灰色为帧间隔；模拟和渲染在两个线程上并行执行，
+          // 各占半列并排从底部画起，而不是叠加在一起
+          const int x_graph = position.x + padding, y_bottom = position.y + padding + height_graph;
+          for (size_t i = 0; i < num_sample; i++)
+          {
+               const Sample &sample = sample_list[(idx_sample + num_sample_max - num_sample + i) % num_sample_max];
+               const int x = x_graph + (int)i * width_bar;
+               const int height_frame = get_bar_height(sample.time_frame);
+               const int height_sim = get_bar_height(sample.time_sim);
+               const int height_render = get_bar_height(sample.time_render);
+
+               snapshot.fill_rect({x, y_bottom - height_frame, width_bar, height_frame}, color_frame);
+               if (height_sim > 0)
+                    snapshot.fill_rect({x, y_bottom - height_sim, width_bar / 2, height_sim}, color_sim);
+               if (height_render > 0)
+                    snapshot.fill_rect({x + width_bar / 2, y_bottom - height_render, width_bar - width_bar / 2, height_render}, color_render);
+          }
+          snapshot.fill_rect({x_graph, y_bottom - get_bar_height(1000.0f / 60), width_graph, 1}, color_budget);
+
+          SDL_Point pos_text = {x_graph, y_bottom + padding};
+          for (const std::string &text : text_line_list)
+          {
+               snapshot.draw_glyph_text(text, pos_text, color_text);
+               pos_text.y += height_line;
+          }
+     }
+
+private:
+     /**
+      * @brief 单帧记录
+      */
+     struct Sample
+     {
+          float time_frame = 0;  ///< 帧间隔（毫秒）
+          float time_sim = 0;    ///< 模拟耗时（毫秒）
+          float time_render = 0; ///< 渲染耗时（毫秒）
+          int num_upload = 0;    ///< 创建的纹理数量
+     };
+
+private:
+     static constexpr size_t num_sample_max = 120;                        ///< 记录的帧数
+     static constexpr int width_bar = 2;                                  ///< 曲线每帧的宽度
+     static constexpr int width_graph = (int)num_sample_max * width_bar;  ///< 曲线宽度
+     static constexpr int height_graph = 64;                              ///< 曲线高度
+     static constexpr float time_graph_max = 1000.0f / 30;                ///< 曲线顶端对应的耗时（毫秒）
+     static constexpr int height_line = 28;                               ///< 文本行高
+     static constexpr int padding = 8;                                    ///< 内边距
+
+     const SDL_Color color_background = {24, 24, 24, 255};
+     const SDL_Color color_frame = {110, 110, 110, 255};
+     const SDL_Color color_sim = {90, 200, 90, 255};
+     const SDL_Color color_render = {230, 150, 60, 255};
+     const SDL_Color color_budget = {230, 70, 70, 255};
+     const SDL_Color color_text = {255, 255, 255, 255};
+
+     bool is_visible = false;                           ///< 是否显示
+     SDL_Point position = {0, 0};                       ///< 左上角位置
+     Timer timer_refresh;                               ///< 文本刷新计时器
+     std::array<Sample, num_sample_max> sample_list;    ///< 环形缓冲
+     size_t idx_sample = 0;                             ///< 下一帧写入的位置
+     size_t num_sample = 0;                             ///< 已记录的帧数
+     std::array<float, num_sample_max> time_sorted;     ///< 计算分位数用的临时数组
+     std::array<std::string, 6> text_line_list;         ///< 显示的文本行
+
+private:
+     int get_bar_height(float time) const
+     {
+          return std::min(height_graph, (int)(time / time_graph_max * height_graph));
+     }
+
+     /**
+      * @brief 计算最近若干帧的统计并重新格式化文本
+      */
+     void refresh_text()
+     {
+          char buffer[64];
+
+          float time_frame_sum = 0, time_sim_sum = 0, time_render_sum = 0;
+          int num_upload_last = 0, num_upload_peak = 0;
+          for (size_t i = 0; i < num_sample; i++)
+          {
+               const Sample &sample = sample_list[i];
+               time_sorted[i] = sample.time_frame;
+               time_frame_sum += sample.time_frame;
+               time_sim_sum += sample.time_sim;
+               time_render_sum += sample.time_render;
+               num_upload_peak = std::max(num_upload_peak, sample.num_upload);
+          }
+          if (num_sample > 0)
+               num_upload_last = sample_list[(idx_sample + num_sample_max - 1) % num_sample_max].num_upload;
+
+          std::sort(time_sorted.begin(), time_sorted.begin() + num_sample);
+          const float count = (float)std::max<size_t>(num_sample, 1);
+          const float time_frame_mean = time_frame_sum / count;
+
+          snprintf(buffer, sizeof(buffer), "FPS %.0f  frame %.2f ms", time_frame_mean > 0 ? 1000 / time_frame_mean : 0, time_frame_mean);
+          text_line_list[0] = buffer;
+          snprintf(buffer, sizeof(buffer), "p50 %.2f  p95 %.2f  p99 %.2f", get_percentile(0.5f), get_percentile(0.95f), get_percentile(0.99f));
+          text_line_list[1] = buffer;
+          snprintf(buffer, sizeof(buffer), "sim %.2f ms  render %.2f ms", time_sim_sum / count, time_render_sum / count);
+          text_line_list[2] = buffer;
+          snprintf(buffer, sizeof(buffer), "enemy %zu  bullet %zu  coin %zu",
+                   EnemyManager::instance()->get_enemy_list().size(),
+                   BulletManager::instance()->get_bullet_list().size(),
+                   CoinManager::instance()->get_coin_prop_list().size());
+          text_line_list[3] = buffer;
+          snprintf(buffer, sizeof(buffer), "tower %zu  timer %d",
+                   TowerManager::instance()->get_tower_list().size(), Timer::get_alive_count());
+          text_line_list[4] = buffer;
+          snprintf(buffer, sizeof(buffer), "upload %d/frame  peak %d", num_upload_last, num_upload_peak);
+          text_line_list[5] = buffer;
+     }
+
+     /**
+      * @brief 从排好序的帧间隔中取分位数
+      * @param ratio 百分位（0-1）
+      */
+     float get_percentile(float ratio) const
+     {
+          if (num_sample == 0)
+               return 0;
+
+          size_t idx = std::min((size_t)(ratio * num_sample), num_sample - 1);
+          return time_sorted[idx];
+     }
+};
+
+#endif // !_DEBUG_OVERLAY_H_
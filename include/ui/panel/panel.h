@@ -7,10 +7,13 @@
 #define _PANEL_H_
 
 #include "game_map/tile.h"
+#include "camera.h"
+#include "render_snapshot.h"
 #include "manager/resources_manager.h"
 
 #include <SDL.h>
 #include <string>
+#include <climits>
 
 /**
  * @class Panel
@@ -30,11 +33,7 @@ public:
      /**
       * @brief 虚析构函数，确保正确释放派生类资源
       */
-     virtual ~Panel()
-     {
-          SDL_DestroyTexture(tex_text_background);
-          SDL_DestroyTexture(tex_text_foreground);
-     }
+     virtual ~Panel() = default;
 
      /**
       * @brief 显示面板
@@ -55,7 +54,7 @@ public:
 
      /**
       * @brief 设置面板的中心位置
-      * @param pos 中心点坐标
+      * @param pos 中心点坐标（世界坐标）
       */
      void set_center_pos(const SDL_Point &pos)
      {
@@ -64,7 +63,7 @@ public:
 
      /**
       * @brief 处理输入事件
-      * @param event SDL事件
+      * @param event SDL事件，鼠标坐标需为世界坐标
       */
      void on_input(const SDL_Event &event)
      {
@@ -77,33 +76,14 @@ public:
           {
                // 检查鼠标是否悬停在面板的各个区域
                SDL_Point pos_cursor = {event.motion.x, event.motion.y};
-               SDL_Rect rect_target = {0, 0, size_button, size_button};
-
-               // 检查顶部区域
-               rect_target.x = center_pos.x - width / 2 + offset_top.x;
-               rect_target.y = center_pos.y - width / 2 + offset_top.y;
-               if (SDL_PointInRect(&pos_cursor, &rect_target))
+               for (HoveredTarget target : {HoveredTarget::Top, HoveredTarget::Left, HoveredTarget::Right})
                {
-                    hovered_target = HoveredTarget::Top;
-                    return;
-               }
-
-               // 检查左侧区域
-               rect_target.x = center_pos.x - width / 2 + offset_left.x;
-               rect_target.y = center_pos.y - width / 2 + offset_left.y;
-               if (SDL_PointInRect(&pos_cursor, &rect_target))
-               {
-                    hovered_target = HoveredTarget::Left;
-                    return;
-               }
-
-               // 检查右侧区域
-               rect_target.x = center_pos.x - width / 2 + offset_right.x;
-               rect_target.y = center_pos.y - width / 2 + offset_right.y;
-               if (SDL_PointInRect(&pos_cursor, &rect_target))
-               {
-                    hovered_target = HoveredTarget::Right;
-                    return;
+                    SDL_Rect rect_target = get_area_rect(center_pos, target);
+                    if (SDL_PointInRect(&pos_cursor, &rect_target))
+                    {
+                         hovered_target = target;
+                         return;
+                    }
                }
 
                hovered_target = HoveredTarget::None;
@@ -137,73 +117,69 @@ public:
 
      /**
       * @brief 更新面板状态
-      * @param renderer SDL渲染器指针
       */
-     virtual void on_update(SDL_Renderer *renderer)
+     virtual void on_update()
      {
-          static TTF_Font *font = ResourcesManager::instance()->get_font_pool().find(ResID::Font_Main)->second;
-
           if (hovered_target == HoveredTarget::None)
                return;
 
-          // 获取当前悬停区域的值
+          // 获取当前悬停区域的值和说明文字
           int val = 0;
+          const char *label = nullptr;
           switch (hovered_target)
           {
           case HoveredTarget::None:
                break;
           case HoveredTarget::Top:
                val = val_top;
+               label = label_top;
                break;
           case HoveredTarget::Left:
                val = val_left;
+               label = label_left;
                break;
           case HoveredTarget::Right:
                val = val_right;
+               label = label_right;
                break;
           }
 
-          // 清理旧的文本纹理
-          SDL_DestroyTexture(tex_text_background);
-          tex_text_background = nullptr;
-          SDL_DestroyTexture(tex_text_foreground);
-          tex_text_foreground = nullptr;
-
-          // 创建新的文本纹理
-          std::string str_val = val < 0 ? "MAX" : std::to_string(val);
-          SDL_Surface *suf_text_background = TTF_RenderText_Blended(font, str_val.c_str(), color_text_background);
-          SDL_Surface *suf_text_foreground = TTF_RenderText_Blended(font, str_val.c_str(), color_text_foreground);
-
-          width_text = suf_text_background->w, height_text = suf_text_background->h;
-          tex_text_background = SDL_CreateTextureFromSurface(renderer, suf_text_background);
-          tex_text_foreground = SDL_CreateTextureFromSurface(renderer, suf_text_foreground);
-
-          SDL_FreeSurface(suf_text_background);
-          SDL_FreeSurface(suf_text_foreground);
+          // 文本纹理由渲染线程根据字符串创建并缓存
+          str_text = label ? label : "";
+          if (val != val_hidden)
+          {
+               if (!str_text.empty())
+                    str_text += ' ';
+               str_text += val < 0 ? "MAX" : std::to_string(val);
+          }
      }
 
      /**
       * @brief 渲染面板
-      * @param renderer SDL渲染器指针
+      * @param snapshot 渲染快照
+      * @param camera 摄像机，用于把面板的世界坐标转换为视图坐标
       */
-     virtual void on_render(SDL_Renderer *renderer)
+     virtual void on_render(RenderSnapshot &snapshot, const Camera &camera)
      {
           if (!visible)
                return;
 
+          const Vector2 pos_view = camera.world_to_view({(double)center_pos.x, (double)center_pos.y});
+          const SDL_Point center_view = {(int)pos_view.x, (int)pos_view.y};
+
           // 渲染选择光标
           SDL_Rect rect_dst_cursor =
               {
-                  center_pos.x - SIZE_TILE / 2,
-                  center_pos.y - SIZE_TILE / 2,
+                  center_view.x - SIZE_TILE / 2,
+                  center_view.y - SIZE_TILE / 2,
                   SIZE_TILE, SIZE_TILE};
-          SDL_RenderCopy(renderer, tex_select_cursor, nullptr, &rect_dst_cursor);
+          snapshot.draw_texture(tex_select_cursor, nullptr, rect_dst_cursor);
 
           // 渲染面板背景
           SDL_Rect rect_dst_panel =
               {
-                  center_pos.x - width / 2,
-                  center_pos.y - height / 2,
+                  center_view.x - width / 2,
+                  center_view.y - height / 2,
                   width, height};
 
           // 根据悬停状态选择面板纹理
@@ -223,24 +199,18 @@ public:
                break;
           }
 
-          SDL_RenderCopy(renderer, tex_panel, nullptr, &rect_dst_panel);
+          snapshot.draw_texture(tex_panel, nullptr, rect_dst_panel);
 
-          if (hovered_target == HoveredTarget::None)
+          if (hovered_target == HoveredTarget::None || str_text.empty())
                return;
 
-          // 渲染文本（带阴影效果）
-          SDL_Rect rect_dst_text;
-
-          // 渲染文本阴影
-          rect_dst_text.x = center_pos.x - width_text / 2 + offset_shadow.x;
-          rect_dst_text.y = center_pos.y + height / 2 + offset_shadow.y;
-          rect_dst_text.w = width_text, rect_dst_text.h = height_text;
-          SDL_RenderCopy(renderer, tex_text_background, nullptr, &rect_dst_text);
+          // 渲染文本（带阴影效果），水平居中于面板下方
+          SDL_Point pos_text = {center_view.x + offset_shadow.x, center_view.y + height / 2 + offset_shadow.y};
+          snapshot.draw_text(str_text, pos_text, color_text_background, 0.5, 0);
 
-          // 渲染文本前景
-          rect_dst_text.x -= offset_shadow.x;
-          rect_dst_text.y -= offset_shadow.y;
-          SDL_RenderCopy(renderer, tex_text_foreground, nullptr, &rect_dst_text);
+          pos_text.x -= offset_shadow.x;
+          pos_text.y -= offset_shadow.y;
+          snapshot.draw_text(str_text, pos_text, color_text_foreground, 0.5, 0);
      }
 
      void set_select_cursor(SDL_Texture *tex) { tex_select_cursor = tex; }
@@ -266,10 +236,31 @@ protected:
      SDL_Texture *tex_hovered_left = nullptr;            ///< 左侧悬停状态纹理
      SDL_Texture *tex_hovered_right = nullptr;           ///< 右侧悬停状态纹理
      SDL_Texture *tex_select_cursor = nullptr;           ///< 选择光标纹理
-     int val_top = 0, val_left = 0, val_right = 0;       ///< 各区域的值
+     int val_top = 0, val_left = 0, val_right = 0;       ///< 各区域的值，为val_hidden时悬停不显示数值
+     const char *label_top = nullptr;                    ///< 悬停顶部区域时显示在数值前的说明文字
+     const char *label_left = nullptr;                   ///< 悬停左侧区域时显示在数值前的说明文字
+     const char *label_right = nullptr;                  ///< 悬停右侧区域时显示在数值前的说明文字
      HoveredTarget hovered_target = HoveredTarget::None; ///< 当前悬停目标
 
+     static constexpr int val_hidden = INT_MIN; ///< 不显示数值的区域值
+
 protected:
+     /**
+      * @brief 获取交互区域的矩形
+      * @param center 面板中心位置，与返回的矩形在同一坐标系中
+      * @param target 交互区域
+      */
+     SDL_Rect get_area_rect(const SDL_Point &center, HoveredTarget target) const
+     {
+          SDL_Point offset = offset_top;
+          if (target == HoveredTarget::Left)
+               offset = offset_left;
+          else if (target == HoveredTarget::Right)
+               offset = offset_right;
+
+          return {center.x - width / 2 + offset.x, center.y - height / 2 + offset.y, size_button, size_button};
+     }
+
      /**
       * @brief 点击顶部区域的处理函数
       */
@@ -293,9 +284,7 @@ private:
      const SDL_Color color_text_background = {175, 175, 175, 255}; ///< 文本阴影颜色
      const SDL_Color color_text_foreground = {255, 255, 255, 255}; ///< 文本前景颜色
 
-     int width_text = 0, height_text = 0;        ///< 文本尺寸
-     SDL_Texture *tex_text_background = nullptr; ///< 文本阴影纹理
-     SDL_Texture *tex_text_foreground = nullptr; ///< 文本前景纹理
+     std::string str_text; ///< 当前悬停区域的数值文本
 };
 
 #endif // !_PANEL_H_
@@ -12,7 +12,6 @@
 #include "manager/resources_manager.h"
 #include "manager/config_manager.h"
 
-#include <SDL2_gfxPrimitives.h>
 
 /**
  * @class PlacePanel
@@ -38,9 +37,8 @@ public:
 
      /**
       * @brief 更新面板状态
-      * @param renderer SDL渲染器指针
       */
-     void on_update(SDL_Renderer *renderer) override
+     void on_update() override
      {
           static TowerManager *instance = TowerManager::instance();
 
@@ -57,10 +55,10 @@ public:
           set_center_pos(pos_tile);
 
           // 调用基类的更新方法
-          Panel::on_update(renderer);
+          Panel::on_update();
      }
 
-     void on_render(SDL_Renderer *renderer) override
+     void on_render(RenderSnapshot &snapshot, const Camera &camera) override
      {
           if (!visible)
                return;
@@ -83,13 +81,13 @@ public:
 
           if (reg > 0)
           {
-               filledCircleRGBA(renderer, center_pos.x, center_pos.y, reg,
-                                color_region_content.r, color_region_content.g, color_region_content.b, color_region_content.a);
-               aacircleRGBA(renderer, center_pos.x, center_pos.y, reg,
-                            color_region_frame.r, color_region_frame.g, color_region_frame.b, color_region_frame.a);
+               const Vector2 pos_view = camera.world_to_view({(double)center_pos.x, (double)center_pos.y});
+               const SDL_Point center_view = {(int)pos_view.x, (int)pos_view.y};
+               snapshot.fill_circle(center_view, reg, color_region_content);
+               snapshot.draw_circle(center_view, reg, color_region_frame);
           }
 
-          Panel::on_render(renderer);
+          Panel::on_render(snapshot, camera);
      }
 
 protected:
@@ -98,13 +96,7 @@ protected:
       */
      void on_click_top_area() override
      {
-          CoinManager *instance = CoinManager::instance();
-
-          if (val_top <= instance->get_current_coin_num())
-          {
-               TowerManager::instance()->place_tower(TowerType::Axeman, idx_tile_selected);
-               instance->decrease_coin(val_top);
-          }
+          try_place_tower(TowerType::Axeman, val_top);
      }
 
      /**
@@ -112,13 +104,7 @@ protected:
       */
      void on_click_left_area() override
      {
-          CoinManager *instance = CoinManager::instance();
-
-          if (val_left <= instance->get_current_coin_num())
-          {
-               TowerManager::instance()->place_tower(TowerType::Archer, idx_tile_selected);
-               instance->decrease_coin(val_left);
-          }
+          try_place_tower(TowerType::Archer, val_left);
      }
 
      /**
@@ -126,13 +112,7 @@ protected:
       */
      void on_click_right_area() override
      {
-          CoinManager *instance = CoinManager::instance();
-
-          if (val_right <= instance->get_current_coin_num())
-          {
-               TowerManager::instance()->place_tower(TowerType::Gunner, idx_tile_selected);
-               instance->decrease_coin(val_right);
-          }
+          try_place_tower(TowerType::Gunner, val_right);
      }
 
 private:
@@ -141,6 +121,30 @@ private:
 
 private:
      int reg_top = 0, reg_left = 0, reg_right = 0;
+
+private:
+     /**
+      * @brief 金币足够且不会阻断任何生成点到终点的路线时放置防御塔
+      * @param type 防御塔类型
+      * @param cost 放置成本
+      */
+     void try_place_tower(TowerType type, int cost)
+     {
+          CoinManager *instance = CoinManager::instance();
+
+          if (cost > instance->get_current_coin_num())
+               return;
+
+          // 自由寻路模式下先查询是否会阻断路线，不会再真正放置
+          if (ConfigManager::instance()->map.would_block_path(idx_tile_selected))
+          {
+               EventBus::instance()->publish(TowerPlaceRejectedEvent{idx_tile_selected});
+               return;
+          }
+
+          TowerManager::instance()->place_tower(type, idx_tile_selected);
+          instance->decrease_coin(cost);
+     }
 };
 
 #endif // !_PLACE_PANEL_H_
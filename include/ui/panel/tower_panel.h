@@ -0,0 +1,160 @@
+/**
+ * @file tower_panel.h
+ * @brief 防御塔面板类，用于管理单座已放置防御塔的界面
+ */
+
+#ifndef _TOWER_PANEL_H_
+#define _TOWER_PANEL_H_
+
+#include "panel.h"
+#include "manager/coin_manager.h"
+#include "manager/tower_manager.h"
+
+/**
+ * @class TowerPanel
+ * @brief 防御塔面板类，继承自Panel基类，点击已放置的防御塔时显示，只作用于这一座塔
+ */
+class TowerPanel : public Panel
+{
+public:
+     /**
+      * @brief 构造函数，初始化各区域的说明文字
+      * @note 面板没有专用的美术资源，三个按钮由渲染快照直接绘制，不复用升级面板的防御塔图标
+      */
+     TowerPanel()
+     {
+          label_top = "UPGRADE";
+          label_left = "SELL";
+          label_right = "MOVE";
+     }
+
+     ~TowerPanel() = default;
+
+     /**
+      * @brief 设置面板作用的防御塔
+      * @param handle 防御塔句柄
+      */
+     void set_tower(TowerHandle handle)
+     {
+          tower_selected = handle;
+     }
+
+     /**
+      * @brief 获取等待迁移的防御塔
+      * @return 点击迁移后等待选择目标瓦片的防御塔，没有时返回空句柄
+      */
+     TowerHandle get_tower_relocating() const
+     {
+          return tower_relocating;
+     }
+
+     /**
+      * @brief 清除迁移请求，选定目标瓦片或取消迁移时调用
+      */
+     void clear_tower_relocating()
+     {
+          tower_relocating = TowerHandle();
+     }
+
+     /**
+      * @brief 更新面板状态，作用的防御塔已被移除时自动隐藏
+      */
+     void on_update() override
+     {
+          Tower *tower = TowerManager::instance()->get_tower(tower_selected);
+          if (!tower)
+          {
+               visible = false;
+               return;
+          }
+
+          val_top = (int)TowerManager::instance()->get_upgrade_cost(tower);
+          val_left = (int)TowerManager::instance()->get_sell_refund(tower);
+          val_right = val_hidden;
+          reg = (int)(tower->get_stats().view_range_pixel);
+
+          Panel::on_update();
+     }
+
+     /**
+      * @brief 渲染面板，同时显示该塔的攻击范围和三个按钮
+      * @param snapshot 渲染快照
+      * @param camera 摄像机
+      */
+     void on_render(RenderSnapshot &snapshot, const Camera &camera) override
+     {
+          if (!visible)
+               return;
+
+          const Vector2 pos_view = camera.world_to_view({(double)center_pos.x, (double)center_pos.y});
+          const SDL_Point center_view = {(int)pos_view.x, (int)pos_view.y};
+
+          if (reg > 0)
+          {
+               snapshot.fill_circle(center_view, reg, color_region_content);
+               snapshot.draw_circle(center_view, reg, color_region_frame);
+          }
+
+          // 按钮上的短标签表明作用，悬停时面板下方显示完整的说明和数值
+          static const HoveredTarget target_list[] = {HoveredTarget::Top, HoveredTarget::Left, HoveredTarget::Right};
+          static const char *const text_button_list[] = {"UP", "$", "MV"};
+          for (int i = 0; i < 3; i++)
+          {
+               const SDL_Rect rect_button = get_area_rect(center_view, target_list[i]);
+               const bool is_hovered = hovered_target == target_list[i];
+               snapshot.fill_rounded_rect(rect_button, radius_button, is_hovered ? color_button_hovered : color_button);
+               snapshot.draw_text(text_button_list[i], {rect_button.x + rect_button.w / 2, rect_button.y + rect_button.h / 2},
+                                  color_button_text, 0.5, 0.5);
+          }
+
+          Panel::on_render(snapshot, camera);
+     }
+
+protected:
+     /**
+      * @brief 处理点击顶部区域的事件（单独升级这座防御塔）
+      */
+     void on_click_top_area() override
+     {
+          CoinManager *instance = CoinManager::instance();
+          Tower *tower = TowerManager::instance()->get_tower(tower_selected);
+
+          if (tower && val_top > 0 && val_top <= instance->get_current_coin_num())
+          {
+               TowerManager::instance()->upgrade_tower(tower);
+               instance->decrease_coin(val_top);
+          }
+     }
+
+     /**
+      * @brief 处理点击左侧区域的事件（出售这座防御塔，按比例返还花费的金币）
+      */
+     void on_click_left_area() override
+     {
+          if (Tower *tower = TowerManager::instance()->get_tower(tower_selected))
+               TowerManager::instance()->sell_tower(tower);
+     }
+
+     /**
+      * @brief 处理点击右侧区域的事件（迁移这座防御塔，下一次点击的瓦片为目标位置）
+      */
+     void on_click_right_area() override
+     {
+          tower_relocating = tower_selected;
+     }
+
+private:
+     const SDL_Color color_region_frame = {30, 80, 162, 175};
+     const SDL_Color color_region_content = {0, 149, 217, 75};
+     const SDL_Color color_button = {40, 40, 40, 200};
+     const SDL_Color color_button_hovered = {120, 90, 30, 230};
+     const SDL_Color color_button_text = {255, 255, 255, 255};
+     const int radius_button = 8;
+
+private:
+     TowerHandle tower_selected;   ///< 面板作用的防御塔
+     TowerHandle tower_relocating; ///< 等待选择目标瓦片的防御塔
+     int reg = 0;                  ///< 攻击范围（像素）
+};
+
+#endif // !_TOWER_PANEL_H_
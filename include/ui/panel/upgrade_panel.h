@@ -34,9 +34,8 @@ public:
 
      /**
       * @brief 更新面板状态
-      * @param renderer SDL渲染器指针
       */
-     void on_update(SDL_Renderer *renderer) override
+     void on_update() override
      {
           static TowerManager *instance = TowerManager::instance();
 
@@ -44,7 +43,7 @@ public:
           val_left = (int)instance->get_upgrade_cost(TowerType::Archer);
           val_right = (int)instance->get_upgrade_cost(TowerType::Gunner);
 
-          Panel::on_update(renderer);
+          Panel::on_update();
      }
 
 protected:
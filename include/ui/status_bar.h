@@ -5,9 +5,9 @@
 #include "manager/home_manager.h"
 #include "manager/resources_manager.h"
 #include "manager/player_manager.h"
+#include "render_snapshot.h"
 
 #include <SDL.h>
-#include <SDL2_gfxPrimitives.h>
 #include <string>
 
 class StatusBar
@@ -21,29 +21,18 @@ public:
           position.x = x, position.y = y;
      }
 
-     void on_update(SDL_Renderer *renderer)
+     void on_update()
      {
-          static TTF_Font *font = ResourcesManager::instance()->get_font_pool().find(ResID::Font_Main)->second;
-
-          SDL_DestroyTexture(tex_text_background);
-          tex_text_background = nullptr;
-          SDL_DestroyTexture(tex_text_foreground);
-          tex_text_foreground = nullptr;
-
-          std::string str_val = std::to_string((int)CoinManager::instance()->get_current_coin_num());
-          SDL_Surface *suf_text_background = TTF_RenderText_Blended(font, str_val.c_str(), color_text_background);
-          SDL_Surface *suf_text_foreground = TTF_RenderText_Blended(font, str_val.c_str(), color_text_foreground);
-
-          width_text = suf_text_background->w, height_text = suf_text_background->h;
-
-          tex_text_background = SDL_CreateTextureFromSurface(renderer, suf_text_background);
-          tex_text_foreground = SDL_CreateTextureFromSurface(renderer, suf_text_foreground);
-
-          SDL_FreeSurface(suf_text_background);
-          SDL_FreeSurface(suf_text_foreground);
+          // 金币数变化时才重新生成字符串
+          int num_coin = (int)CoinManager::instance()->get_current_coin_num();
+          if (num_coin != num_coin_last || str_coin.empty())
+          {
+               num_coin_last = num_coin;
+               str_coin = std::to_string(num_coin);
+          }
      }
 
-     void on_render(SDL_Renderer *renderer)
+     void on_render(RenderSnapshot &snapshot)
      {
           static SDL_Rect rect_dst;
           static const ResourcesManager::TexturePool &tex_pool = ResourcesManager::instance()->get_texture_pool();
@@ -54,47 +43,43 @@ public:
 
           rect_dst.x = position.x, rect_dst.y = position.y;
           rect_dst.w = 78, rect_dst.h = 78;
-          SDL_RenderCopy(renderer, tex_home_avatar, nullptr, &rect_dst);
+          snapshot.draw_texture(tex_home_avatar, nullptr, rect_dst);
 
           for (int i = 0; i < (int)HomeManager::instance()->get_current_hp_num(); i++)
           {
                rect_dst.x = position.x + 78 + 15 + i * (32 + 2);
                rect_dst.y = position.y;
                rect_dst.w = 32, rect_dst.h = 32;
-               SDL_RenderCopy(renderer, tex_heart, nullptr, &rect_dst);
+               snapshot.draw_texture(tex_heart, nullptr, rect_dst);
           }
 
           rect_dst.x = position.x + 78 + 15;
           rect_dst.y = position.y + 78 - 32;
           rect_dst.w = 32, rect_dst.h = 32;
-          SDL_RenderCopy(renderer, tex_coin, nullptr, &rect_dst);
+          snapshot.draw_texture(tex_coin, nullptr, rect_dst);
 
-          rect_dst.x += 32 + 10 + offset_shadow.x;
-          rect_dst.y = rect_dst.y + (32 - height_text) / 2 + offset_shadow.y;
-          rect_dst.w = width_text, rect_dst.h = height_text;
-          SDL_RenderCopy(renderer, tex_text_background, nullptr, &rect_dst);
+          SDL_Point pos_text = {rect_dst.x + 32 + 10 + offset_shadow.x, rect_dst.y + 32 / 2 + offset_shadow.y};
+          snapshot.draw_text(str_coin, pos_text, color_text_background, 0, 0.5);
 
-          rect_dst.x -= offset_shadow.x;
-          rect_dst.y -= offset_shadow.y;
-          SDL_RenderCopy(renderer, tex_text_foreground, nullptr, &rect_dst);
+          pos_text.x -= offset_shadow.x;
+          pos_text.y -= offset_shadow.y;
+          snapshot.draw_text(str_coin, pos_text, color_text_foreground, 0, 0.5);
 
           rect_dst.x = position.x + (78 - 65) / 2;
           rect_dst.y = position.y + 78 + 5;
           rect_dst.w = 65, rect_dst.h = 65;
-          SDL_RenderCopy(renderer, tex_player_avatar, nullptr, &rect_dst);
+          snapshot.draw_texture(tex_player_avatar, nullptr, rect_dst);
 
           rect_dst.x = position.x + 78 + 15;
           rect_dst.y += 10;
-          roundedBoxRGBA(renderer, rect_dst.x, rect_dst.y, rect_dst.x + width_mp_bar, rect_dst.y + height_mp_bar, 4,
-                         color_mp_bar_background.r, color_mp_bar_background.g, color_mp_bar_background.b, color_mp_bar_background.a);
+          snapshot.fill_rounded_rect({rect_dst.x, rect_dst.y, width_mp_bar, height_mp_bar}, 4, color_mp_bar_background);
 
           rect_dst.x += width_border_mp_bar;
           rect_dst.y += width_border_mp_bar;
           rect_dst.w = width_mp_bar - 2 * width_border_mp_bar;
           rect_dst.h = height_mp_bar - 2 * width_border_mp_bar;
           double process = PlayerManager::instance()->get_current_mp() / 100;
-          roundedBoxRGBA(renderer, rect_dst.x, rect_dst.y, rect_dst.x + (int)(rect_dst.w * process), rect_dst.y + rect_dst.h, 2,
-                         color_mp_bar_foredground.r, color_mp_bar_foredground.g, color_mp_bar_foredground.b, color_mp_bar_foredground.a);
+          snapshot.fill_rounded_rect({rect_dst.x, rect_dst.y, (int)(rect_dst.w * process), rect_dst.h}, 2, color_mp_bar_foredground);
      }
 
 private:
@@ -110,9 +95,8 @@ private:
 
 private:
      SDL_Point position = {0};
-     int width_text = 0, height_text = 0;
-     SDL_Texture *tex_text_background = nullptr;
-     SDL_Texture *tex_text_foreground = nullptr;
+     std::string str_coin;
+     int num_coin_last = 0;
 };
 
 #endif // !_STATUS_BAR_H_
@@ -0,0 +1,78 @@
+/**
+ * @file tile_reject_marker.h
+ * @brief 放置被拒绝时在瓦片上闪烁的红色提示
+ */
+
+#ifndef _TILE_REJECT_MARKER_H_
+#define _TILE_REJECT_MARKER_H_
+
+#include "camera.h"
+#include "render_snapshot.h"
+#include "manager/config_manager.h"
+
+#include <SDL.h>
+
+/**
+ * @class TileRejectMarker
+ * @brief 放置或迁移防御塔会阻断路线时，在目标瓦片上闪烁片刻，告诉玩家操作没有生效
+ */
+class TileRejectMarker
+{
+public:
+     TileRejectMarker() = default;
+     ~TileRejectMarker() = default;
+
+     /**
+      * @brief 在指定瓦片上开始闪烁，已在闪烁时改为新的瓦片并重新计时
+      * @param idx_tile 瓦片坐标
+      */
+     void show(const SDL_Point &idx_tile)
+     {
+          this->idx_tile = idx_tile;
+          time_left = duration;
+     }
+
+     /**
+      * @brief 更新剩余显示时间
+      * @param delta 时间增量（秒）
+      */
+     void on_update(double delta)
+     {
+          if (time_left > 0)
+               time_left -= delta;
+     }
+
+     /**
+      * @brief 把提示录制到快照的世界层
+      */
+     void on_render(RenderSnapshot &snapshot, const Camera &camera)
+     {
+          static const SDL_Rect &rect_tile_map = ConfigManager::instance()->rect_tile_map;
+
+          // 每个闪烁周期的前半段显示
+          if (time_left <= 0 || (int)(time_left / interval_blink) % 2 != 0)
+               return;
+
+          const Vector2 position = {(double)(rect_tile_map.x + idx_tile.x * SIZE_TILE), (double)(rect_tile_map.y + idx_tile.y * SIZE_TILE)};
+          const Vector2 size = {(double)SIZE_TILE, (double)SIZE_TILE};
+          if (!camera.is_visible(position + size * 0.5, size))
+               return;
+
+          const Vector2 pos_view = camera.world_to_view(position);
+          const SDL_Rect rect = {(int)pos_view.x, (int)pos_view.y, SIZE_TILE, SIZE_TILE};
+          snapshot.fill_rect(rect, color_content);
+          snapshot.draw_rect(rect, color_frame);
+     }
+
+private:
+     static constexpr double duration = 0.6;        ///< 闪烁总时长（秒）
+     static constexpr double interval_blink = 0.15; ///< 闪烁半周期（秒）
+
+     const SDL_Color color_content = {220, 40, 40, 110};
+     const SDL_Color color_frame = {220, 40, 40, 220};
+
+     SDL_Point idx_tile = {0, 0}; ///< 提示的瓦片
+     double time_left = 0;        ///< 剩余显示时间（秒）
+};
+
+#endif // !_TILE_REJECT_MARKER_H_
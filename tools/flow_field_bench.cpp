@@ -0,0 +1,240 @@
+// 流场增量修复基准测试
+// 在大尺寸的随机地图上模拟放置、出售和迁移防御塔：放置和迁移前先做阻挡查询，不会阻断路线时再增量修复流场；
+// 同时对同一地图完整重新计算流场，核对步数、流向和阻挡查询的结果一致，并输出两种方式每一步的耗时
+//
+// 用法：flow_field_bench [宽度] [高度] [步数] [障碍密度百分比] [核对间隔]
+// 核对间隔为N时每N步完整重新计算并核对一次，地图很大时可以调大以缩短运行时间
+
+#include "game_map/flow_field.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// 与 Map::is_walkable 相同的规则：终点和生成点始终可通行，否则没有装饰物且没有防御塔才可通行
+static bool is_walkable(const Tile &tile)
+{
+     if (tile.special_flag >= 0)
+          return true;
+
+     return tile.decoration < 0 && !tile.has_tower();
+}
+
+// 生成合成地图：随机分布的装饰物作为障碍，终点在地图中央，八个生成点分布在四角和四边中点
+static void generate_map(TileMap &map, SDL_Point &idx_home, std::vector<SDL_Point> &idx_spawner_list, int width, int height, int density)
+{
+     unsigned int seed = 12345;
+     auto random = [&seed]() {
+          seed = seed * 1103515245 + 12345;
+          return (seed >> 16) & 0x7fff;
+     };
+
+     map.resize(width, height);
+     for (int y = 0; y < height; y++)
+          for (int x = 0; x < width; x++)
+               map.at(x, y).decoration = (int)(random() % 100) < density ? 0 : -1;
+
+     idx_home = {width / 2, height / 2};
+     map.at(idx_home).special_flag = 0;
+
+     idx_spawner_list = {{0, 0}, {width / 2, 0}, {width - 1, 0}, {0, height / 2}, {width - 1, height / 2}, {0, height - 1}, {width / 2, height - 1}, {width - 1, height - 1}};
+     for (size_t i = 0; i < idx_spawner_list.size(); i++)
+          map.at(idx_spawner_list[i]).special_flag = (int8_t)(i + 1);
+}
+
+// 两个流场的步数和流向必须逐瓦片一致
+static bool is_same_field(const FlowField &a, const FlowField &b, int width, int height)
+{
+     for (int y = 0; y < height; y++)
+          for (int x = 0; x < width; x++)
+          {
+               if (a.get_cost({x, y}) != b.get_cost({x, y}) || a.get_direction({x, y}) != b.get_direction({x, y}))
+                    return false;
+          }
+
+     return true;
+}
+
+int main(int argc, char **argv)
+{
+     int width = argc > 1 ? std::atoi(argv[1]) : 256;
+     int height = argc > 2 ? std::atoi(argv[2]) : 256;
+     int num_step = argc > 3 ? std::atoi(argv[3]) : 2000;
+     int density = argc > 4 ? std::atoi(argv[4]) : 20;
+     int interval_check = argc > 5 ? std::max(std::atoi(argv[5]), 1) : 1;
+
+     TileMap map;
+     SDL_Point idx_home;
+     std::vector<SDL_Point> idx_spawner_list;
+     generate_map(map, idx_home, idx_spawner_list, width, height, density);
+
+     FlowField field_incremental, field_full;
+     field_incremental.build(map, idx_home, is_walkable);
+
+     unsigned int seed = 67890;
+     auto random = [&seed]() {
+          seed = seed * 1103515245 + 12345;
+          return (seed >> 16) & 0x7fff;
+     };
+
+     std::vector<SDL_Point> tower_list;
+     int num_place = 0, num_sell = 0, num_relocate = 0, num_reject = 0, num_check = 0, num_mismatch = 0;
+     double time_incremental = 0, time_full = 0;
+
+     typedef std::chrono::steady_clock Clock;
+     for (int step = 0; step < num_step; step++)
+     {
+          const bool is_check = step % interval_check == 0;
+
+          // 四分之一的步骤出售一座已有的防御塔，八分之一的步骤把一座防御塔迁移到随机的可通行瓦片，
+          // 其余步骤尝试在随机的可通行瓦片上放置
+          const int action = (int)(random() % 8);
+          if (!tower_list.empty() && action == 0)
+          {
+               size_t idx = ((size_t)random() << 15 | random()) % tower_list.size();
+               SDL_Point idx_src = tower_list[idx];
+               SDL_Point idx_dst = {(int)(((size_t)random() << 15 | random()) % width), (int)(((size_t)random() << 15 | random()) % height)};
+               if (map.at(idx_dst).special_flag >= 0 || !is_walkable(map.at(idx_dst)))
+                    continue;
+
+               std::vector<bool> reachable_list;
+               if (is_check)
+               {
+                    for (const SDL_Point &idx_spawner : idx_spawner_list)
+                         reachable_list.push_back(field_incremental.is_reachable(idx_spawner));
+               }
+
+               // 阻挡查询把原瓦片视为可通行，不修改流场；通过后再释放原瓦片、阻挡目标瓦片
+               Clock::time_point begin = Clock::now();
+               bool is_blocked = field_incremental.would_block(idx_dst, idx_spawner_list, idx_src);
+               if (!is_blocked)
+               {
+                    field_incremental.set_walkable(idx_src, true);
+                    field_incremental.set_walkable(idx_dst, false);
+               }
+               time_incremental += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+               if (is_check)
+               {
+                    map.at(idx_src).set_has_tower(false);
+                    map.at(idx_dst).set_has_tower(true);
+                    begin = Clock::now();
+                    field_full.build(map, idx_home, is_walkable);
+                    bool is_blocked_full = false;
+                    for (size_t i = 0; i < idx_spawner_list.size(); i++)
+                    {
+                         if (reachable_list[i] && !field_full.is_reachable(idx_spawner_list[i]))
+                              is_blocked_full = true;
+                    }
+                    time_full += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+                    map.at(idx_src).set_has_tower(true);
+                    map.at(idx_dst).set_has_tower(false);
+
+                    num_check++;
+                    if (is_blocked != is_blocked_full)
+                         num_mismatch++;
+                    else if (!is_blocked && !is_same_field(field_incremental, field_full, width, height))
+                         num_mismatch++;
+               }
+
+               if (is_blocked)
+               {
+                    num_reject++;
+                    continue;
+               }
+
+               map.at(idx_src).set_has_tower(false);
+               map.at(idx_dst).set_has_tower(true);
+               tower_list[idx] = idx_dst;
+               num_relocate++;
+               continue;
+          }
+
+          if (!tower_list.empty() && action <= 2)
+          {
+               size_t idx = ((size_t)random() << 15 | random()) % tower_list.size();
+               SDL_Point idx_tile = tower_list[idx];
+               tower_list[idx] = tower_list.back();
+               tower_list.pop_back();
+               map.at(idx_tile).set_has_tower(false);
+               num_sell++;
+
+               Clock::time_point begin = Clock::now();
+               field_incremental.set_walkable(idx_tile, true);
+               time_incremental += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+               if (is_check)
+               {
+                    begin = Clock::now();
+                    field_full.build(map, idx_home, is_walkable);
+                    time_full += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+                    num_check++;
+                    if (!is_same_field(field_incremental, field_full, width, height))
+                         num_mismatch++;
+               }
+               continue;
+          }
+
+          SDL_Point idx_tile = {(int)(((size_t)random() << 15 | random()) % width), (int)(((size_t)random() << 15 | random()) % height)};
+          if (map.at(idx_tile).special_flag >= 0 || !is_walkable(map.at(idx_tile)))
+               continue;
+
+          // 放置前各生成点是否可达，用于核对阻挡查询
+          std::vector<bool> reachable_list;
+          if (is_check)
+          {
+               for (const SDL_Point &idx_spawner : idx_spawner_list)
+                    reachable_list.push_back(field_incremental.is_reachable(idx_spawner));
+          }
+
+          Clock::time_point begin = Clock::now();
+          bool is_blocked = field_incremental.would_block(idx_tile, idx_spawner_list);
+          if (!is_blocked)
+               field_incremental.set_walkable(idx_tile, false);
+          time_incremental += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+          if (is_check)
+          {
+               // 完整重新计算：先按已阻挡的地图计算流场，再检查是否有原本可达的生成点变得不可达
+               map.at(idx_tile).set_has_tower(true);
+               begin = Clock::now();
+               field_full.build(map, idx_home, is_walkable);
+               bool is_blocked_full = false;
+               for (size_t i = 0; i < idx_spawner_list.size(); i++)
+               {
+                    if (reachable_list[i] && !field_full.is_reachable(idx_spawner_list[i]))
+                         is_blocked_full = true;
+               }
+               time_full += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+               map.at(idx_tile).set_has_tower(false);
+
+               num_check++;
+               if (is_blocked != is_blocked_full)
+                    num_mismatch++;
+               else if (!is_blocked && !is_same_field(field_incremental, field_full, width, height))
+                    num_mismatch++;
+          }
+
+          if (is_blocked)
+          {
+               num_reject++;
+               continue;
+          }
+
+          map.at(idx_tile).set_has_tower(true);
+          tower_list.push_back(idx_tile);
+          num_place++;
+     }
+
+     int num_op = num_place + num_sell + num_relocate + num_reject;
+     std::printf("map %dx%d, %d%% obstacles, %d placed, %d sold, %d relocated, %d rejected, %d checks\n",
+                 width, height, density, num_place, num_sell, num_relocate, num_reject, num_check);
+     std::printf("%-12s %10.4f ms/step\n", "incremental", num_op > 0 ? time_incremental / num_op : 0);
+     std::printf("%-12s %10.4f ms/step\n", "full", num_check > 0 ? time_full / num_check : 0);
+     std::printf("mismatched steps: %d\n", num_mismatch);
+
+     return num_mismatch == 0 ? 0 : 1;
+}
@@ -0,0 +1,60 @@
+// 地图格式转换工具
+// 读取CSV地图，追踪生成点路径后写出二进制地图，游戏加载时可跳过文本解析和路径追踪
+//
+// 用法：map_convert [输入CSV] [输出文件]
+// 默认把 config/map.csv 转换为 config/map.tdmap
+
+#include "game_map/map.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+int main(int argc, char **argv)
+{
+     std::string path_input = argc > 1 ? argv[1] : "config/map.csv";
+     std::string path_output = argc > 2 ? argv[2] : "config/map.tdmap";
+
+     Map map;
+     if (!map.load(path_input))
+          return 1;
+
+     if (!map.save_binary(path_output))
+     {
+          std::fprintf(stderr, "Failed to write binary map: %s\n", path_output.c_str());
+          return 1;
+     }
+
+     // 重新加载输出文件，确认内容与源地图一致
+     auto begin = std::chrono::steady_clock::now();
+     Map map_check;
+     if (!map_check.load(path_output))
+          return 1;
+     std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+
+     const std::vector<Tile> &list_src = map.get_tile_map().get_tile_list();
+     const std::vector<Tile> &list_dst = map_check.get_tile_map().get_tile_list();
+     bool is_same = list_src.size() == list_dst.size() && map.get_idx_spawner_pool().size() == map_check.get_idx_spawner_pool().size()
+                    && map.get_idx_home().x == map_check.get_idx_home().x && map.get_idx_home().y == map_check.get_idx_home().y;
+     for (size_t i = 0; is_same && i < list_src.size(); i++)
+     {
+          const Tile &a = list_src[i], &b = list_dst[i];
+          is_same = a.terrian == b.terrian && a.decoration == b.decoration && a.get_direction() == b.get_direction() && a.special_flag == b.special_flag;
+     }
+     for (const auto &pair : map.get_idx_spawner_pool())
+     {
+          auto itor = map_check.get_idx_spawner_pool().find(pair.first);
+          is_same = is_same && itor != map_check.get_idx_spawner_pool().end() && itor->second.get_idx_list().size() == pair.second.get_idx_list().size();
+     }
+
+     if (!is_same)
+     {
+          std::fprintf(stderr, "Binary map does not match source map: %s\n", path_output.c_str());
+          return 1;
+     }
+
+     std::printf("%s -> %s: %zux%zu tiles, %zu routes, reload %.3f ms\n", path_input.c_str(), path_output.c_str(),
+                 map.get_width(), map.get_height(), map.get_idx_spawner_pool().size(), elapsed.count());
+
+     return 0;
+}
@@ -0,0 +1,384 @@
+// 压力测试地图和关卡生成工具
+// 生成任意尺寸的CSV地图：N个生成点分布在地图边缘，每个生成点沿一条蜿蜒的道路到达终点，
+// 道路由瓦片上的方向标记串成，可以直接被Route追踪；同时生成每波敌人数量可配置的关卡文件，
+// 用于从几十到十万个同屏敌人的基准测试
+//
+// 用法：map_gen [选项]
+//   --width N            地图宽度（瓦片），默认64
+//   --height N           地图高度（瓦片），默认64
+//   --spawners N         生成点数量，1-127，默认4
+//   --waves N            波次数量，默认10
+//   --enemies-first N    第一波的敌人数量，默认10
+//   --enemies-last N     最后一波的敌人数量，默认1000，中间各波按几何级数插值
+//   --interval S         同一波内相邻敌人的生成间隔（秒），0表示同一帧内全部生成，默认0.1
+//   --wave-interval S    波次之间的等待时间（秒），默认3
+//   --decoration R       非道路瓦片上出现装饰物的概率，默认0.05
+//   --seed N             随机种子，默认1
+//   --map PATH           输出地图路径，默认map_gen.csv
+//   --level PATH         输出关卡路径，默认map_gen_level.json
+
+#include "game_map/tile.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+
+// 与 config/map.csv 使用的瓦片集索引保持一致
+static const int terrain_road_horizontal = 3;
+static const int terrain_road_vertical = 4;
+static const int terrain_home = 5;
+static const int decoration_list[] = {29, 53, 54};
+
+static const char *const enemy_name_list[] = {"Slim", "KingSlim", "Skeleton", "Goblin", "GoblinPriest"};
+static const int enemy_weight_list[] = {8, 2, 4, 4, 1};
+
+struct Options
+{
+     int width = 64;
+     int height = 64;
+     int num_spawner = 4;
+     int num_wave = 10;
+     int num_enemy_first = 10;
+     int num_enemy_last = 1000;
+     double interval = 0.1;
+     double wave_interval = 3;
+     double decoration_ratio = 0.05;
+     unsigned int seed = 1;
+     std::string path_map = "map_gen.csv";
+     std::string path_level = "map_gen_level.json";
+};
+
+// 生成中的瓦片：路径归属用于合并道路和擦除环路
+struct GenTile
+{
+     Tile tile;
+     int id_route = -1;    // 所属生成点路线，-1表示不是道路
+     int idx_in_path = -1; // 在正在铺设的路线中的位置，-1表示不在其中
+};
+
+class MapGenerator
+{
+public:
+     MapGenerator(const Options &options) : options(options), random(options.seed)
+     {
+          tile_list.resize((size_t)options.width * options.height);
+     }
+
+     bool generate()
+     {
+          idx_home = {options.width / 2, options.height / 2};
+          at(idx_home).tile.terrian = terrain_home;
+          at(idx_home).tile.special_flag = 0;
+          at(idx_home).id_route = 0;
+
+          int perimeter = 2 * (options.width + options.height) - 4;
+          if (options.num_spawner > perimeter)
+          {
+               std::fprintf(stderr, "Map edge only has room for %d spawners\n", perimeter);
+               return false;
+          }
+
+          std::vector<SDL_Point> idx_spawner_list = place_spawner_list();
+          for (size_t i = 0; i < idx_spawner_list.size(); i++)
+          {
+               if (!trace_route((int)i + 1, idx_spawner_list[i]))
+               {
+                    std::fprintf(stderr, "Failed to connect spawner %zu to home\n", i + 1);
+                    return false;
+               }
+          }
+
+          scatter_decoration();
+          return true;
+     }
+
+     bool write_map(const std::string &path) const
+     {
+          FILE *file = std::fopen(path.c_str(), "wb");
+          if (!file)
+               return false;
+
+          std::string str_line;
+          for (int y = 0; y < options.height; y++)
+          {
+               str_line.clear();
+               for (int x = 0; x < options.width; x++)
+               {
+                    const Tile &tile = tile_list[(size_t)y * options.width + x].tile;
+                    if (x > 0)
+                         str_line += ',';
+                    str_line += std::to_string(tile.terrian) + "\\" + std::to_string(tile.decoration) + "\\" + std::to_string((int)tile.get_direction()) + "\\" + std::to_string(tile.special_flag);
+               }
+               str_line += '\n';
+               std::fwrite(str_line.data(), 1, str_line.size(), file);
+          }
+
+          return std::fclose(file) == 0;
+     }
+
+     bool write_level(const std::string &path)
+     {
+          FILE *file = std::fopen(path.c_str(), "wb");
+          if (!file)
+               return false;
+
+          std::discrete_distribution<int> enemy_distribution(std::begin(enemy_weight_list), std::end(enemy_weight_list));
+
+          std::fprintf(file, "[\n");
+          for (int i = 0; i < options.num_wave; i++)
+          {
+               // 各波敌人数量在首尾之间按几何级数插值，便于跨越多个数量级
+               double t = options.num_wave > 1 ? (double)i / (options.num_wave - 1) : 0;
+               int num_enemy = (int)std::lround(options.num_enemy_first * std::pow((double)options.num_enemy_last / options.num_enemy_first, t));
+               num_enemy = std::max(1, num_enemy);
+
+               std::fprintf(file, "  {\n    \"interval\": %g,\n    \"rewards\": 100,\n    \"spawn_list\": [\n", options.wave_interval);
+               for (int j = 0; j < num_enemy; j++)
+               {
+                    std::fprintf(file, "      {\"interval\": %g, \"point\": %d, \"enemy\": \"%s\"}%s\n", options.interval,
+                                 j % options.num_spawner + 1, enemy_name_list[enemy_distribution(random)], j + 1 < num_enemy ? "," : "");
+               }
+               std::fprintf(file, "    ]\n  }%s\n", i + 1 < options.num_wave ? "," : "");
+          }
+          std::fprintf(file, "]\n");
+
+          return std::fclose(file) == 0;
+     }
+
+private:
+     const Options &options;
+     std::mt19937 random;
+     std::vector<GenTile> tile_list;
+     SDL_Point idx_home = {0, 0};
+
+private:
+     GenTile &at(const SDL_Point &idx)
+     {
+          return tile_list[(size_t)idx.y * options.width + idx.x];
+     }
+
+     bool is_inside(const SDL_Point &idx) const
+     {
+          return idx.x >= 0 && idx.y >= 0 && idx.x < options.width && idx.y < options.height;
+     }
+
+     // 沿地图边缘等距放置生成点
+     std::vector<SDL_Point> place_spawner_list()
+     {
+          std::vector<SDL_Point> idx_spawner_list;
+          int perimeter = 2 * (options.width + options.height) - 4;
+          for (int i = 0; i < options.num_spawner; i++)
+          {
+               int offset = (int)((long long)perimeter * i / options.num_spawner);
+               SDL_Point idx;
+               if (offset < options.width)
+                    idx = {offset, 0};
+               else if ((offset -= options.width) < options.height - 1)
+                    idx = {options.width - 1, offset + 1};
+               else if ((offset -= options.height - 1) < options.width - 1)
+                    idx = {options.width - 2 - offset, options.height - 1};
+               else
+                    idx = {0, options.height - 2 - (offset - (options.width - 1))};
+
+               idx_spawner_list.push_back(idx);
+          }
+
+          return idx_spawner_list;
+     }
+
+     // 用偏向终点、带惯性的随机游走铺设道路，走回自己走过的瓦片时擦除形成的环（环路擦除随机游走），
+     // 碰到其他路线的道路时合并进去，最终每个生成点都沿方向标记通向终点
+     bool trace_route(int id_route, const SDL_Point &idx_spawner)
+     {
+          static const SDL_Point offset_list[4] = {{0, -1}, {0, 1}, {-1, 0}, {1, 0}};
+          static const Tile::Direction direction_list[4] = {Tile::Direction::Up, Tile::Direction::Down, Tile::Direction::Left, Tile::Direction::Right};
+
+          // 生成点落在已有道路上时，直接沿用那条道路
+          if (at(idx_spawner).id_route >= 0)
+          {
+               at(idx_spawner).tile.special_flag = (int8_t)id_route;
+               return at(idx_spawner).id_route != 0;
+          }
+
+          std::vector<SDL_Point> path = {idx_spawner};
+          at(idx_spawner).idx_in_path = 0;
+          std::vector<int> idx_direction_list;
+          std::uniform_real_distribution<double> chance(0, 1);
+          int idx_heading = -1;
+
+          size_t num_step_max = (size_t)options.width * options.height * 16;
+          for (size_t step = 0; step < num_step_max; step++)
+          {
+               const SDL_Point &idx_current = path.back();
+
+               // 候选方向：保持当前方向形成较长的直道，否则偏向终点，偶尔随机拐弯形成弯道
+               int idx_next = -1;
+               if (idx_heading >= 0 && chance(random) < 0.6)
+                    idx_next = idx_heading;
+               else if (chance(random) < 0.65)
+               {
+                    int dx = idx_home.x - idx_current.x, dy = idx_home.y - idx_current.y;
+                    bool is_horizontal = dy == 0 || (dx != 0 && chance(random) < (double)std::abs(dx) / (std::abs(dx) + std::abs(dy)));
+                    idx_next = is_horizontal ? (dx < 0 ? 2 : 3) : (dy < 0 ? 0 : 1);
+               }
+               else
+                    idx_next = (int)(random() % 4);
+
+               SDL_Point idx_target = {idx_current.x + offset_list[idx_next].x, idx_current.y + offset_list[idx_next].y};
+               if (!is_inside(idx_target))
+               {
+                    idx_heading = -1;
+                    continue;
+               }
+               idx_heading = idx_next;
+
+               // 走回自己的路线：擦除从该瓦片开始形成的环
+               int idx_in_path = at(idx_target).idx_in_path;
+               if (idx_in_path >= 0)
+               {
+                    for (size_t i = (size_t)idx_in_path + 1; i < path.size(); i++)
+                         at(path[i]).idx_in_path = -1;
+                    path.resize((size_t)idx_in_path + 1);
+                    idx_direction_list.resize((size_t)idx_in_path);
+                    continue;
+               }
+
+               idx_direction_list.push_back(idx_next);
+               at(idx_target).idx_in_path = (int)path.size();
+               path.push_back(idx_target);
+
+               // 到达终点或其他路线的道路，路线完成
+               if (at(idx_target).id_route >= 0)
+               {
+                    commit_route(id_route, path, idx_direction_list, direction_list);
+                    return true;
+               }
+          }
+
+          return false;
+     }
+
+     void commit_route(int id_route, const std::vector<SDL_Point> &path, const std::vector<int> &idx_direction_list, const Tile::Direction *direction_list)
+     {
+          for (const SDL_Point &idx : path)
+               at(idx).idx_in_path = -1;
+
+          for (size_t i = 0; i < idx_direction_list.size(); i++)
+          {
+               GenTile &gen_tile = at(path[i]);
+               bool is_horizontal = idx_direction_list[i] >= 2;
+
+               gen_tile.id_route = id_route;
+               gen_tile.tile.terrian = is_horizontal ? terrain_road_horizontal : terrain_road_vertical;
+               gen_tile.tile.set_direction(direction_list[idx_direction_list[i]]);
+          }
+
+          at(path.front()).tile.special_flag = (int8_t)id_route;
+     }
+
+     void scatter_decoration()
+     {
+          std::uniform_real_distribution<double> chance(0, 1);
+          for (GenTile &gen_tile : tile_list)
+          {
+               if (gen_tile.id_route >= 0 || chance(random) >= options.decoration_ratio)
+                    continue;
+
+               gen_tile.tile.decoration = (int16_t)decoration_list[random() % (sizeof(decoration_list) / sizeof(decoration_list[0]))];
+          }
+     }
+};
+
+static bool parse_options(int argc, char **argv, Options &options)
+{
+     for (int i = 1; i < argc; i++)
+     {
+          const char *key = argv[i];
+          if (i + 1 >= argc)
+          {
+               std::fprintf(stderr, "Missing value for option %s\n", key);
+               return false;
+          }
+          const char *value = argv[++i];
+
+          if (!std::strcmp(key, "--width"))
+               options.width = std::atoi(value);
+          else if (!std::strcmp(key, "--height"))
+               options.height = std::atoi(value);
+          else if (!std::strcmp(key, "--spawners"))
+               options.num_spawner = std::atoi(value);
+          else if (!std::strcmp(key, "--waves"))
+               options.num_wave = std::atoi(value);
+          else if (!std::strcmp(key, "--enemies-first"))
+               options.num_enemy_first = std::atoi(value);
+          else if (!std::strcmp(key, "--enemies-last"))
+               options.num_enemy_last = std::atoi(value);
+          else if (!std::strcmp(key, "--interval"))
+               options.interval = std::atof(value);
+          else if (!std::strcmp(key, "--wave-interval"))
+               options.wave_interval = std::atof(value);
+          else if (!std::strcmp(key, "--decoration"))
+               options.decoration_ratio = std::atof(value);
+          else if (!std::strcmp(key, "--seed"))
+               options.seed = (unsigned int)std::strtoul(value, nullptr, 10);
+          else if (!std::strcmp(key, "--map"))
+               options.path_map = value;
+          else if (!std::strcmp(key, "--level"))
+               options.path_level = value;
+          else
+          {
+               std::fprintf(stderr, "Unknown option %s\n", key);
+               return false;
+          }
+     }
+
+     if (options.width < 3 || options.height < 3)
+     {
+          std::fprintf(stderr, "Map must be at least 3x3 tiles\n");
+          return false;
+     }
+     if (options.num_spawner < 1 || options.num_spawner > INT8_MAX)
+     {
+          std::fprintf(stderr, "Spawner count must be in [1, %d]\n", INT8_MAX);
+          return false;
+     }
+     if (options.num_wave < 1 || options.num_enemy_first < 1 || options.num_enemy_last < 1 || options.interval < 0)
+     {
+          std::fprintf(stderr, "Wave count and enemy counts must be positive, interval must not be negative\n");
+          return false;
+     }
+
+     return true;
+}
+
+int main(int argc, char **argv)
+{
+     Options options;
+     if (!parse_options(argc, argv, options))
+          return 1;
+
+     MapGenerator generator(options);
+     if (!generator.generate())
+          return 1;
+
+     if (!generator.write_map(options.path_map))
+     {
+          std::fprintf(stderr, "Failed to write map: %s\n", options.path_map.c_str());
+          return 1;
+     }
+     if (!generator.write_level(options.path_level))
+     {
+          std::fprintf(stderr, "Failed to write level: %s\n", options.path_level.c_str());
+          return 1;
+     }
+
+     std::printf("%dx%d map with %d spawners -> %s, %d waves (%d to %d enemies) -> %s\n", options.width, options.height, options.num_spawner,
+                 options.path_map.c_str(), options.num_wave, options.num_enemy_first, options.num_enemy_last, options.path_level.c_str());
+
+     return 0;
+}
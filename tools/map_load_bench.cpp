@@ -0,0 +1,184 @@
+// 地图加载基准测试
+// 生成大尺寸的合成CSV地图，分别用旧的 getline + stringstream + stoi 逐行解析
+// 和新的内存映射单遍解析器加载，核对结果一致并输出耗时和吞吐量
+//
+// 用法：map_load_bench [宽度] [高度] [重复次数]
+
+#include "game_map/map_parser.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// 旧的解析方式，仅用于对比
+static std::string trim_str(const std::string &str)
+{
+     size_t begin_idx = str.find_first_not_of(" \t");
+     if (begin_idx == std::string::npos)
+          return "";
+     size_t end_idx = str.find_last_not_of(" \t");
+
+     return str.substr(begin_idx, end_idx - begin_idx + 1);
+}
+
+static void load_tile_from_string(Tile &tile, const std::string &str)
+{
+     std::string str_value;
+     std::vector<int> values;
+     std::stringstream str_stream(trim_str(str));
+
+     while (std::getline(str_stream, str_value, '\\'))
+     {
+          int value;
+          try
+          {
+               value = std::stoi(str_value);
+          }
+          catch (const std::invalid_argument &)
+          {
+               value = -1;
+          }
+          values.push_back(value);
+     }
+
+     tile.terrian = (uint16_t)((values.size() < 1 || values[0] < 0) ? 0 : values[0]);
+     tile.decoration = (int16_t)((values.size() < 2) ? -1 : values[1]);
+     tile.set_direction((Tile::Direction)((values.size() < 3 || values[2] < 0) ? 0 : values[2]));
+     tile.special_flag = (int8_t)((values.size() <= 3) ? -1 : values[3]);
+}
+
+static bool load_legacy(const std::string &path, TileMap &dst)
+{
+     std::ifstream file(path);
+     if (!file.good())
+          return false;
+
+     std::vector<Tile> tile_list;
+     size_t width = 0, height = 0;
+
+     std::string str_line;
+     while (std::getline(file, str_line))
+     {
+          str_line = trim_str(str_line);
+          if (str_line.empty())
+               continue;
+
+          size_t num_tile_line = 0;
+          std::string str_tile;
+          std::stringstream str_stream(str_line);
+          while (std::getline(str_stream, str_tile, ','))
+          {
+               tile_list.emplace_back();
+               load_tile_from_string(tile_list.back(), str_tile);
+               num_tile_line++;
+          }
+
+          if (height == 0)
+               width = num_tile_line;
+          else if (num_tile_line != width)
+               return false;
+          height++;
+     }
+
+     dst.assign(width, height, std::move(tile_list));
+     return true;
+}
+
+// 生成合成地图：随机地形和装饰，一条蛇形道路，若干生成点和一个终点
+static void generate_map(const std::string &path, int width, int height)
+{
+     std::ofstream file(path, std::ios::binary);
+     unsigned int seed = 12345;
+     auto random = [&seed]() {
+          seed = seed * 1103515245 + 12345;
+          return (seed >> 16) & 0x7fff;
+     };
+
+     std::string str_line;
+     for (int y = 0; y < height; y++)
+     {
+          str_line.clear();
+          for (int x = 0; x < width; x++)
+          {
+               int terrain = random() % 8;
+               int decoration = (random() % 10 == 0) ? (int)(random() % 16) : -1;
+               int direction = 0, flag = -1;
+               if (y % 4 == 1)
+                    direction = (y / 4) % 2 == 0 ? 4 : 3;
+               if (y == height - 2 && x == width / 2)
+                    flag = 0;
+               else if (x == 0 && y % 64 == 1)
+                    flag = 1 + (y / 64) % 127;
+
+               str_line += std::to_string(terrain) + "\\" + std::to_string(decoration) + "\\" + std::to_string(direction) + "\\" + std::to_string(flag);
+               if (x + 1 < width)
+                    str_line += ',';
+          }
+          str_line += '\n';
+          file << str_line;
+     }
+}
+
+int main(int argc, char **argv)
+{
+     int width = argc > 1 ? std::atoi(argv[1]) : 1024;
+     int height = argc > 2 ? std::atoi(argv[2]) : 1024;
+     int num_round = argc > 3 ? std::atoi(argv[3]) : 5;
+
+     const std::string path = "map_load_bench.csv";
+     generate_map(path, width, height);
+
+     MappedFile file(path);
+     double size_mb = file.size() / (1024.0 * 1024.0);
+     file.close();
+     std::printf("map %dx%d, %.1f MB, %d rounds\n", width, height, size_mb, num_round);
+
+     auto measure = [num_round](const char *name, double size_mb, auto &&load) {
+          double time_best = 1e30;
+          for (int i = 0; i < num_round; i++)
+          {
+               auto begin = std::chrono::steady_clock::now();
+               if (!load())
+               {
+                    std::printf("%s: load failed\n", name);
+                    std::exit(1);
+               }
+               std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - begin;
+               if (elapsed.count() < time_best)
+                    time_best = elapsed.count();
+          }
+          std::printf("%-8s %10.2f ms %10.1f MB/s\n", name, time_best, size_mb / (time_best / 1000.0));
+     };
+
+     TileMap map_legacy, map_fast;
+     MapParseError error;
+     measure("legacy", size_mb, [&]() { return load_legacy(path, map_legacy); });
+     measure("mmap", size_mb, [&]() {
+          if (MapParser::load_csv(path, map_fast, error))
+               return true;
+          std::cerr << error.to_string(path) << std::endl;
+          return false;
+     });
+
+     // 两种方式的解析结果必须完全一致
+     const std::vector<Tile> &list_legacy = map_legacy.get_tile_list();
+     const std::vector<Tile> &list_fast = map_fast.get_tile_list();
+     size_t num_mismatch = 0;
+     for (size_t i = 0; i < list_legacy.size() && i < list_fast.size(); i++)
+     {
+          const Tile &a = list_legacy[i], &b = list_fast[i];
+          if (a.terrian != b.terrian || a.decoration != b.decoration || a.get_direction() != b.get_direction() || a.special_flag != b.special_flag)
+               num_mismatch++;
+     }
+     if (list_legacy.size() != list_fast.size())
+          num_mismatch++;
+     std::printf("mismatched tiles: %zu\n", num_mismatch);
+
+     std::remove(path.c_str());
+     return num_mismatch == 0 ? 0 : 1;
+}
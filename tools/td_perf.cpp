@@ -0,0 +1,458 @@
+// 性能回归测试
+// 不创建窗口，在map_gen生成的地图和关卡上运行确定性的场景，推进固定的帧数，
+// 记录每帧耗时（纳秒）、每帧内存分配次数和模拟期间峰值常驻内存的增长，与仓库中的基准文件比较，
+// 任一指标超过基准加容差、或基准文件中没有该场景时返回非零值，由CTest判定为失败
+//
+// 每帧执行的是与游戏主循环相同的SimulationManager::on_update，
+// 敌人、防御塔、子弹热路径上的改动都会反映在结果中
+//
+// 用法：td_perf --scenario NAME --map PATH --level PATH [选项]
+//   --scenario NAME      场景名，对应基准文件中的条目
+//   --map PATH           地图文件
+//   --level PATH         关卡文件
+//   --ticks N            推进的帧数，默认600（按60帧每秒即10秒游戏时间）
+//   --towers 0|1         是否在道路两侧所有可放置的瓦片上放满防御塔，默认0
+//   --seed N             随机种子，默认1
+//   --baseline PATH      基准文件，默认tools/td_perf_baseline.json
+//   --write-baseline 0|1 为1时用本次结果写入或更新基准文件中的该场景，不做比较，默认0；
+//                        新增场景必须先这样记录一次
+//   --stats PATH         推进完所有帧后把StatsManager的统计写入该CSV文件，默认不写出
+//
+// 需要在仓库根目录运行（读取config/config.json和resources/）；
+// SDL使用dummy视频和音频驱动，资源加载到软件渲染器上
+
+#define SDL_MAIN_HANDLED
+
+#include "manager/config_manager.h"
+#include "manager/resources_manager.h"
+#include "manager/tower_manager.h"
+#include "manager/stats_manager.h"
+#include "manager/simulation_manager.h"
+
+#include <SDL.h>
+#include <SDL_image.h>
+#include <SDL_ttf.h>
+#include <SDL_mixer.h>
+#include <cJSON.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+
+// 统计全局的内存分配次数（包括任务系统的工作线程）
+// 默认的数组版本和nothrow版本都会转调这里的operator new
+static std::atomic<uint64_t> num_alloc{0};
+
+void *operator new(size_t size)
+{
+     num_alloc.fetch_add(1, std::memory_order_relaxed);
+
+     if (void *ptr = std::malloc(size ? size : 1))
+          return ptr;
+     throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+     std::free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+     std::free(ptr);
+}
+
+struct Options
+{
+     std::string name;
+     std::string path_map;
+     std::string path_level;
+     int num_tick = 600;
+     bool is_tower_layout = false;
+     unsigned int seed = 1;
+     std::string path_baseline = "tools/td_perf_baseline.json";
+     bool is_write_baseline = false;
+     std::string path_stats;
+};
+
+// 一个场景的测量结果，也是基准文件中一个条目的内容
+// 峰值常驻内存只统计推进帧期间的增长，SDL和资源加载占用的内存因平台而异，不参与比较
+struct Metrics
+{
+     double ns_per_tick = 0;     // 每帧耗时（纳秒）
+     double allocs_per_tick = 0; // 每帧内存分配次数
+     double peak_rss_kb = 0;     // 峰值常驻内存的增长（KB）
+};
+
+// 基准文件：各指标的相对容差、绝对余量和每个场景的基准值
+// 指标超过"基准 * (1 + 容差) + 余量"时判定为退化；余量用于每帧分配次数这类很小的整数值，
+// 以及峰值常驻内存的增长：增长本身可能只有几百KB，分配器按页和按块申请内存带来的抖动需要固定的余量吸收
+struct Baseline
+{
+     Metrics tolerance = {0.5, 0.1, 0.25};
+     Metrics slack = {0, 1, 2048};
+     std::vector<std::pair<std::string, Metrics>> scenario_list;
+
+     Metrics *find(const std::string &name)
+     {
+          for (auto &pair : scenario_list)
+               if (pair.first == name)
+                    return &pair.second;
+          return nullptr;
+     }
+};
+
+static double get_number(const cJSON *json, const char *key, double default_value)
+{
+     const cJSON *item = cJSON_GetObjectItem(json, key);
+     return (item && item->type == cJSON_Number) ? item->valuedouble : default_value;
+}
+
+static Metrics parse_metrics(const cJSON *json, const Metrics &default_value)
+{
+     Metrics metrics;
+     metrics.ns_per_tick = get_number(json, "ns_per_tick", default_value.ns_per_tick);
+     metrics.allocs_per_tick = get_number(json, "allocs_per_tick", default_value.allocs_per_tick);
+     metrics.peak_rss_kb = get_number(json, "peak_rss_kb", default_value.peak_rss_kb);
+     return metrics;
+}
+
+static bool load_baseline(const std::string &path, Baseline &baseline)
+{
+     std::ifstream file(path);
+     if (!file.good())
+          return false;
+
+     std::stringstream str_stream;
+     str_stream << file.rdbuf();
+
+     cJSON *json_root = cJSON_Parse(str_stream.str().c_str());
+     if (!json_root || json_root->type != cJSON_Object)
+     {
+          cJSON_Delete(json_root);
+          return false;
+     }
+
+     const cJSON *json_tolerance = cJSON_GetObjectItem(json_root, "tolerance");
+     if (json_tolerance && json_tolerance->type == cJSON_Object)
+          baseline.tolerance = parse_metrics(json_tolerance, baseline.tolerance);
+
+     const cJSON *json_slack = cJSON_GetObjectItem(json_root, "slack");
+     if (json_slack && json_slack->type == cJSON_Object)
+          baseline.slack = parse_metrics(json_slack, baseline.slack);
+
+     const cJSON *json_scenarios = cJSON_GetObjectItem(json_root, "scenarios");
+     const cJSON *json_scenario = nullptr;
+     if (json_scenarios && json_scenarios->type == cJSON_Object)
+     {
+          cJSON_ArrayForEach(json_scenario, json_scenarios)
+          {
+               if (json_scenario->type == cJSON_Object)
+                    baseline.scenario_list.emplace_back(json_scenario->string, parse_metrics(json_scenario, Metrics()));
+          }
+     }
+
+     cJSON_Delete(json_root);
+     return true;
+}
+
+static bool write_baseline(const std::string &path, const Baseline &baseline)
+{
+     FILE *file = std::fopen(path.c_str(), "wb");
+     if (!file)
+          return false;
+
+     std::fprintf(file, "{\n");
+     std::fprintf(file, "  \"tolerance\": {\"ns_per_tick\": %g, \"allocs_per_tick\": %g, \"peak_rss_kb\": %g},\n",
+                  baseline.tolerance.ns_per_tick, baseline.tolerance.allocs_per_tick, baseline.tolerance.peak_rss_kb);
+     std::fprintf(file, "  \"slack\": {\"ns_per_tick\": %g, \"allocs_per_tick\": %g, \"peak_rss_kb\": %g},\n",
+                  baseline.slack.ns_per_tick, baseline.slack.allocs_per_tick, baseline.slack.peak_rss_kb);
+     std::fprintf(file, "  \"scenarios\": {\n");
+     for (size_t i = 0; i < baseline.scenario_list.size(); i++)
+     {
+          const auto &pair = baseline.scenario_list[i];
+          std::fprintf(file, "    \"%s\": {\"ns_per_tick\": %.0f, \"allocs_per_tick\": %.2f, \"peak_rss_kb\": %.0f}%s\n",
+                       pair.first.c_str(), pair.second.ns_per_tick, pair.second.allocs_per_tick, pair.second.peak_rss_kb,
+                       i + 1 < baseline.scenario_list.size() ? "," : "");
+     }
+     std::fprintf(file, "  }\n}\n");
+
+     return std::fclose(file) == 0;
+}
+
+static double get_peak_rss_kb()
+{
+#ifdef _WIN32
+     return 0;
+#else
+     rusage usage;
+     if (getrusage(RUSAGE_SELF, &usage) != 0)
+          return 0;
+#ifdef __APPLE__
+     return (double)usage.ru_maxrss / 1024; // macOS以字节为单位
+#else
+     return (double)usage.ru_maxrss; // Linux以KB为单位
+#endif
+#endif
+}
+
+// 初始化无窗口的SDL环境并加载游戏资源、配置、地图和关卡，步骤与GameManager的构造函数一致
+static bool init_game(const Options &options)
+{
+     SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+     SDL_setenv("SDL_AUDIODRIVER", "dummy", 1);
+
+     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_AUDIO) != 0)
+     {
+          std::fprintf(stderr, "SDL_Init failed: %s\n", SDL_GetError());
+          return false;
+     }
+     IMG_Init(IMG_INIT_JPG | IMG_INIT_PNG);
+     Mix_Init(MIX_INIT_MP3);
+     TTF_Init();
+     Mix_OpenAudio(44100, MIX_DEFAULT_FORMAT, 2, 2048);
+
+     SDL_Surface *suf_target = SDL_CreateRGBSurfaceWithFormat(0, 64, 64, 32, SDL_PIXELFORMAT_ARGB8888);
+     SDL_Renderer *renderer = suf_target ? SDL_CreateSoftwareRenderer(suf_target) : nullptr;
+     if (!renderer)
+     {
+          std::fprintf(stderr, "Failed to create software renderer: %s\n", SDL_GetError());
+          return false;
+     }
+
+     if (!ResourcesManager::instance()->load_from_file(renderer))
+     {
+          std::fprintf(stderr, "Failed to load resources, run td_perf from the repository root\n");
+          return false;
+     }
+
+     ConfigManager *config = ConfigManager::instance();
+     if (!config->load_game_config("config/config.json"))
+     {
+          std::fprintf(stderr, "Failed to load config/config.json\n");
+          return false;
+     }
+
+     // 固定使用道路寻路，结果不受配置文件中自由寻路开关的影响
+     config->map.set_free_pathing(false);
+     if (!config->map.load(options.path_map))
+     {
+          std::fprintf(stderr, "Failed to load map: %s\n", options.path_map.c_str());
+          return false;
+     }
+     if (!config->load_level_config(options.path_level))
+     {
+          std::fprintf(stderr, "Failed to load level: %s\n", options.path_level.c_str());
+          return false;
+     }
+
+     config->rect_tile_map = {0, 0, (int)config->map.get_width() * SIZE_TILE, (int)config->map.get_height() * SIZE_TILE};
+
+     TowerManager::instance()->refresh_stats();
+     TowerManager::instance()->reset_tower_grid();
+     StatsManager::instance()->start(config->wave_list.size());
+
+     return true;
+}
+
+// 在与道路相邻的所有可放置瓦片上依次放置三种防御塔
+// @return: 放置的防御塔数量
+static int place_tower_layout()
+{
+     const Map &map = ConfigManager::instance()->map;
+     const TileMap &tile_map = map.get_tile_map();
+     const SDL_Point &idx_home = map.get_idx_home();
+     const int width = (int)map.get_width(), height = (int)map.get_height();
+
+     std::vector<SDL_Point> idx_tile_list;
+     for (int y = 0; y < height; y++)
+     {
+          for (int x = 0; x < width; x++)
+          {
+               const Tile &tile = tile_map.at(x, y);
+               if (tile.decoration >= 0 || tile.special_flag >= 0 || tile.get_direction() != Tile::Direction::None)
+                    continue;
+               if (x == idx_home.x && y == idx_home.y)
+                    continue;
+
+               bool is_next_to_road = false;
+               for (int dy = -1; dy <= 1 && !is_next_to_road; dy++)
+               {
+                    for (int dx = -1; dx <= 1 && !is_next_to_road; dx++)
+                    {
+                         int nx = x + dx, ny = y + dy;
+                         if (nx >= 0 && ny >= 0 && nx < width && ny < height)
+                              is_next_to_road = tile_map.at(nx, ny).get_direction() != Tile::Direction::None;
+                    }
+               }
+
+               if (is_next_to_road)
+                    idx_tile_list.push_back({x, y});
+          }
+     }
+
+     static const TowerType tower_type_list[] = {Archer, Axeman, Gunner};
+     for (size_t i = 0; i < idx_tile_list.size(); i++)
+          TowerManager::instance()->place_tower(tower_type_list[i % 3], idx_tile_list[i]);
+
+     return (int)idx_tile_list.size();
+}
+
+static bool parse_options(int argc, char **argv, Options &options)
+{
+     for (int i = 1; i < argc; i++)
+     {
+          const char *key = argv[i];
+          if (i + 1 >= argc)
+          {
+               std::fprintf(stderr, "Missing value for option %s\n", key);
+               return false;
+          }
+          const char *value = argv[++i];
+
+          if (!std::strcmp(key, "--scenario"))
+               options.name = value;
+          else if (!std::strcmp(key, "--map"))
+               options.path_map = value;
+          else if (!std::strcmp(key, "--level"))
+               options.path_level = value;
+          else if (!std::strcmp(key, "--ticks"))
+               options.num_tick = std::atoi(value);
+          else if (!std::strcmp(key, "--towers"))
+               options.is_tower_layout = std::atoi(value) != 0;
+          else if (!std::strcmp(key, "--seed"))
+               options.seed = (unsigned int)std::strtoul(value, nullptr, 10);
+          else if (!std::strcmp(key, "--baseline"))
+               options.path_baseline = value;
+          else if (!std::strcmp(key, "--write-baseline"))
+               options.is_write_baseline = std::atoi(value) != 0;
+          else if (!std::strcmp(key, "--stats"))
+               options.path_stats = value;
+          else
+          {
+               std::fprintf(stderr, "Unknown option %s\n", key);
+               return false;
+          }
+     }
+
+     if (options.name.empty() || options.path_map.empty() || options.path_level.empty())
+     {
+          std::fprintf(stderr, "--scenario, --map and --level are required\n");
+          return false;
+     }
+     if (options.num_tick < 1)
+     {
+          std::fprintf(stderr, "Tick count must be positive\n");
+          return false;
+     }
+
+     return true;
+}
+
+// 检查单个指标，超过基准加容差和余量时返回false
+static bool check_metric(const char *name, double value, double value_baseline, double tolerance, double slack)
+{
+     double limit = value_baseline * (1 + tolerance) + slack;
+     bool is_passed = value <= limit;
+     std::printf("  %-16s %14.2f  baseline %14.2f  limit %14.2f  %+7.1f%%  %s\n", name, value, value_baseline, limit,
+                 value_baseline > 0 ? (value / value_baseline - 1) * 100 : 0.0, is_passed ? "ok" : "REGRESSION");
+     return is_passed;
+}
+
+int main(int argc, char **argv)
+{
+     Options options;
+     if (!parse_options(argc, argv, options))
+          return 1;
+
+     std::srand(options.seed);
+
+     if (!init_game(options))
+          return 1;
+
+     int num_tower = options.is_tower_layout ? place_tower_layout() : 0;
+
+     // 固定时间步长推进，结果只取决于地图、关卡和随机种子
+     const double delta = 1.0 / 60;
+     SimulationManager *simulation = SimulationManager::instance();
+
+     double peak_rss_kb_begin = get_peak_rss_kb();
+     uint64_t num_alloc_begin = num_alloc.load(std::memory_order_relaxed);
+     auto time_begin = std::chrono::steady_clock::now();
+
+     for (int i = 0; i < options.num_tick; i++)
+          simulation->on_update(delta);
+
+     auto time_end = std::chrono::steady_clock::now();
+     uint64_t num_alloc_end = num_alloc.load(std::memory_order_relaxed);
+
+     Metrics metrics;
+     metrics.ns_per_tick = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(time_end - time_begin).count() / options.num_tick;
+     metrics.allocs_per_tick = (double)(num_alloc_end - num_alloc_begin) / options.num_tick;
+     double peak_rss_kb_end = get_peak_rss_kb();
+     metrics.peak_rss_kb = peak_rss_kb_end - peak_rss_kb_begin;
+
+     std::printf("%s: %d ticks, %d towers, %zu enemies alive at end, peak RSS %.0f KB\n", options.name.c_str(), options.num_tick, num_tower,
+                 EnemyManager::instance()->get_enemy_list().size(), peak_rss_kb_end);
+
+     // 统计在计时结束后写出，文件写入不计入测量结果
+     if (!options.path_stats.empty() && !StatsManager::instance()->write_csv(options.path_stats))
+          return 1;
+
+     Baseline baseline;
+     bool is_baseline_loaded = load_baseline(options.path_baseline, baseline);
+
+     if (options.is_write_baseline)
+     {
+          if (Metrics *metrics_baseline = baseline.find(options.name))
+               *metrics_baseline = metrics;
+          else
+               baseline.scenario_list.emplace_back(options.name, metrics);
+
+          if (!write_baseline(options.path_baseline, baseline))
+          {
+               std::fprintf(stderr, "Failed to write baseline: %s\n", options.path_baseline.c_str());
+               return 1;
+          }
+          std::printf("  ns/tick %.0f, allocs/tick %.2f, peak RSS growth %.0f KB -> %s\n", metrics.ns_per_tick, metrics.allocs_per_tick,
+                      metrics.peak_rss_kb, options.path_baseline.c_str());
+          return 0;
+     }
+
+     if (!is_baseline_loaded)
+     {
+          std::fprintf(stderr, "Failed to load baseline: %s\n", options.path_baseline.c_str());
+          return 1;
+     }
+
+     // 没有基准的场景视为失败，否则新增或改名的场景会一直不被比较
+     const Metrics *found = baseline.find(options.name);
+     if (!found)
+     {
+          std::fprintf(stderr, "No baseline for scenario '%s' in %s; record it with --write-baseline 1\n",
+                       options.name.c_str(), options.path_baseline.c_str());
+          return 1;
+     }
+     const Metrics &metrics_baseline = *found;
+
+     bool is_passed = true;
+     is_passed &= check_metric("ns/tick", metrics.ns_per_tick, metrics_baseline.ns_per_tick,
+                               baseline.tolerance.ns_per_tick, baseline.slack.ns_per_tick);
+     is_passed &= check_metric("allocs/tick", metrics.allocs_per_tick, metrics_baseline.allocs_per_tick,
+                               baseline.tolerance.allocs_per_tick, baseline.slack.allocs_per_tick);
+     is_passed &= check_metric("RSS growth (KB)", metrics.peak_rss_kb, metrics_baseline.peak_rss_kb,
+                               baseline.tolerance.peak_rss_kb, baseline.slack.peak_rss_kb);
+
+     return is_passed ? 0 : 1;
+}